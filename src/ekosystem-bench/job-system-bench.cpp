@@ -0,0 +1,187 @@
+#include <ekosystem/job-system.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string_view>
+#include <vector>
+
+using namespace eks;
+
+using Clock = std::chrono::steady_clock;
+
+//  Threads counts to compare, including the calling thread
+static constexpr int THREADS_COUNTS[] = { 1, 2, 4, 8, 16 };
+
+static double get_elapsed_ns( Clock::time_point start_time )
+{
+	return std::chrono::duration<double, std::nano>( Clock::now() - start_time ).count();
+}
+
+/*
+ * Deterministic busy work standing for the decision phase of a pawn.
+ */
+static uint64_t compute_work( int index, int iterations_count )
+{
+	uint64_t hash = 0xcbf29ce484222325ull ^ static_cast<uint64_t>( index );
+	for ( int i = 0; i < iterations_count; i++ )
+	{
+		hash ^= hash >> 33;
+		hash *= 0xff51afd7ed558ccdull;
+		hash ^= hash >> 29;
+	}
+	return hash;
+}
+
+/*
+ * Measures the cost of queuing, running and waiting on empty jobs, with and without a dependency.
+ * Returns whenever all dependent jobs started after their dependency was done.
+ */
+static bool bench_scheduling_overhead( JobSystem& job_system, int jobs_count )
+{
+	//  Independent jobs
+	Clock::time_point start_time = Clock::now();
+	{
+		JobCounter counter {};
+		for ( int i = 0; i < jobs_count; i++ )
+		{
+			job_system.run( [] {}, &counter );
+		}
+		job_system.wait( counter );
+	}
+	const double run_ns = get_elapsed_ns( start_time ) / jobs_count;
+
+	//  Single index batches
+	start_time = Clock::now();
+	job_system.parallel_for( jobs_count, 1, []( int, int ) {} );
+	const double parallel_for_ns = get_elapsed_ns( start_time ) / jobs_count;
+
+	//  Jobs parked until all the jobs of their dependency are done
+	std::atomic<int> done_count { 0 };
+	std::atomic<int> early_count { 0 };
+	start_time = Clock::now();
+	{
+		JobCounter first_counter {};
+		JobCounter second_counter {};
+		for ( int i = 0; i < jobs_count / 2; i++ )
+		{
+			job_system.run( [&] { done_count.fetch_add( 1, std::memory_order_relaxed ); }, &first_counter );
+		}
+		for ( int i = 0; i < jobs_count / 2; i++ )
+		{
+			job_system.run(
+				[&]
+				{
+					if ( done_count.load( std::memory_order_relaxed ) != jobs_count / 2 )
+					{
+						early_count.fetch_add( 1, std::memory_order_relaxed );
+					}
+				},
+				&second_counter, &first_counter
+			);
+		}
+		job_system.wait( second_counter );
+	}
+	const double dependency_ns = get_elapsed_ns( start_time ) / ( jobs_count / 2 * 2 );
+
+	printf( "  %2d threads | run: %7.1fns/job | parallel_for: %7.1fns/batch | dependency: %7.1fns/job\n",
+		job_system.get_threads_count(), run_ns, parallel_for_ns, dependency_ns );
+
+	if ( early_count.load() > 0 )
+	{
+		printf( "  ERROR: %d jobs started before their dependency was done\n", early_count.load() );
+		return false;
+	}
+	return true;
+}
+
+/*
+ * Runs the busy work over all items with the given threads and compares the results against the reference.
+ * Returns the elapsed time in milliseconds, or a negative value if the results differ.
+ */
+static double bench_scaling( JobSystem& job_system, int items_count, int iterations_count, const std::vector<uint64_t>& reference )
+{
+	std::vector<uint64_t> results( static_cast<size_t>( items_count ), 0 );
+
+	const Clock::time_point start_time = Clock::now();
+	job_system.parallel_for( items_count, 256,
+		[&]( int begin, int end )
+		{
+			for ( int i = begin; i < end; i++ )
+			{
+				results[i] = compute_work( i, iterations_count );
+			}
+		}
+	);
+	const double elapsed_ms = get_elapsed_ns( start_time ) * 1.0e-6;
+
+	return results == reference ? elapsed_ms : -1.0;
+}
+
+/*
+ * Measures the scheduling overhead of the job system and how a synthetic workload scales
+ * with the threads count, checking the results match the ones of a single thread.
+ */
+int main( int arg_count, char** args )
+{
+	int jobs_count = 100000;
+	int items_count = 20000;
+	int iterations_count = 2000;
+	for ( int i = 1; i + 1 < arg_count; i += 2 )
+	{
+		const std::string_view arg = args[i];
+		if ( arg == "--jobs" )
+		{
+			jobs_count = std::max( 2, atoi( args[i + 1] ) );
+		}
+		else if ( arg == "--items" )
+		{
+			items_count = std::max( 1, atoi( args[i + 1] ) );
+		}
+		else if ( arg == "--iterations" )
+		{
+			iterations_count = std::max( 1, atoi( args[i + 1] ) );
+		}
+	}
+
+	bool is_success = true;
+
+	printf( "Scheduling overhead of %d empty jobs\n", jobs_count );
+	for ( int threads_count : THREADS_COUNTS )
+	{
+		JobSystem job_system( threads_count );
+		is_success &= bench_scheduling_overhead( job_system, jobs_count );
+	}
+
+	printf( "\nScaling of %d items of %d iterations\n", items_count, iterations_count );
+	std::vector<uint64_t> reference( static_cast<size_t>( items_count ) );
+	for ( int i = 0; i < items_count; i++ )
+	{
+		reference[i] = compute_work( i, iterations_count );
+	}
+
+	double single_thread_ms = 0.0;
+	for ( int threads_count : THREADS_COUNTS )
+	{
+		JobSystem job_system( threads_count );
+		const double elapsed_ms = bench_scaling( job_system, items_count, iterations_count, reference );
+		if ( elapsed_ms < 0.0 )
+		{
+			printf( "  %2d threads | ERROR: results differ from the single thread ones\n", threads_count );
+			is_success = false;
+			continue;
+		}
+
+		if ( threads_count == 1 )
+		{
+			single_thread_ms = elapsed_ms;
+		}
+		printf( "  %2d threads | %8.2fms | speedup: %5.2fx\n",
+			job_system.get_threads_count(), elapsed_ms, single_thread_ms / elapsed_ms );
+	}
+
+	return is_success ? 0 : 1;
+}
@@ -0,0 +1,129 @@
+#include <suprengine/core/engine.h>
+#include <suprengine/core/assets.h>
+
+#include <ekosystem/entities/pawn.h>
+#include <ekosystem-headless/scenario.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+using namespace suprengine;
+using namespace eks;
+
+using Clock = std::chrono::steady_clock;
+
+/*
+ * Simulates the scenario with or without the Morton ordering of the pawns and returns the
+ * elapsed time in milliseconds per step, or a negative value if a pawn handle got remapped
+ * to another pawn or if the scenario can't be loaded.
+ */
+static double run_world( const std::string& scenario_path, int steps_count, int threads_count, bool is_morton_ordering_enabled )
+{
+	Engine& engine = Engine::instance();
+	JobSystem job_system( threads_count );
+
+	World* world = load_scenario( scenario_path, &job_system );
+	if ( world == nullptr ) return -1.0;
+
+	const float step = world->fixed_timestep;
+	world->is_morton_ordering_enabled = is_morton_ordering_enabled;
+
+	//  Handles of the initial pawns, which must keep resolving to them while they are alive
+	std::vector<std::pair<PawnHandle, Pawn*>> handles {};
+	for ( const SafePtr<Pawn>& pawn : world->get_pawns() )
+	{
+		handles.emplace_back( pawn->get_handle(), pawn.get() );
+	}
+
+	const Clock::time_point start_time = Clock::now();
+	for ( int i = 0; i < steps_count; i++ )
+	{
+		world->update( step );
+
+		//  Release the killed pawns, without the windowed loop
+		engine.update( step );
+	}
+	const double elapsed_ms = std::chrono::duration<double, std::milli>( Clock::now() - start_time ).count();
+
+	//  Removed pawns invalidate their handles, so a resolved handle must give back the same pawn
+	int remapped_count = 0;
+	for ( const auto& [handle, pawn] : handles )
+	{
+		const Pawn* resolved_pawn = world->get_pawn( handle );
+		if ( resolved_pawn != nullptr && resolved_pawn != pawn )
+		{
+			remapped_count++;
+		}
+	}
+	for ( const SafePtr<Pawn>& pawn : world->get_pawns() )
+	{
+		if ( world->get_pawn( pawn->get_handle() ) != pawn.get() )
+		{
+			remapped_count++;
+		}
+	}
+
+	delete world;
+
+	//  Release the pawns killed by the world's destruction
+	engine.update( 0.0f );
+
+	if ( remapped_count > 0 )
+	{
+		printf( "  ERROR: %d pawn handles resolve to another pawn\n", remapped_count );
+		return -1.0;
+	}
+	return elapsed_ms / steps_count;
+}
+
+/*
+ * Compares the time per step of a crowded world with the pawns ticked in their spawn order
+ * and re-sorted along a Z-order curve, checking the pawn handles survive the re-sorts.
+ */
+int main( int arg_count, char** args )
+{
+	std::string scenario_path = "assets/ekosystem/data/scenarios/bench-20k.json";
+	int steps_count = 600;
+	int threads_count = 1;
+	for ( int i = 1; i + 1 < arg_count; i += 2 )
+	{
+		const std::string_view arg = args[i];
+		if ( arg == "--scenario" )
+		{
+			scenario_path = args[i + 1];
+		}
+		else if ( arg == "--steps" )
+		{
+			steps_count = std::max( 1, atoi( args[i + 1] ) );
+		}
+		else if ( arg == "--threads" )
+		{
+			threads_count = std::max( 1, atoi( args[i + 1] ) );
+		}
+	}
+
+	Assets::load_curves_in_folder(
+		"assets/ekosystem/curves/",
+		/* is_recursive */ true,
+		/* should_auto_reload */ false
+	);
+
+	printf( "Simulating '%s' for %d steps with %d threads\n", scenario_path.c_str(), steps_count, threads_count );
+
+	const double unordered_ms = run_world( scenario_path, steps_count, threads_count, /* is_morton_ordering_enabled */ false );
+	if ( unordered_ms < 0.0 ) return 1;
+	printf( "  spawn order  | %7.3fms per step\n", unordered_ms );
+
+	const double ordered_ms = run_world( scenario_path, steps_count, threads_count, /* is_morton_ordering_enabled */ true );
+	if ( ordered_ms < 0.0 ) return 1;
+	printf( "  morton order | %7.3fms per step | speedup: %5.2fx\n", ordered_ms, ordered_ms > 0.0 ? unordered_ms / ordered_ms : 0.0 );
+
+	return 0;
+}
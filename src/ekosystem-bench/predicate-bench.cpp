@@ -0,0 +1,174 @@
+#include <suprengine/core/engine.h>
+
+#include <ekosystem/entities/pawn.h>
+#include <ekosystem-headless/scenario.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace suprengine;
+using namespace eks;
+
+using Clock = std::chrono::steady_clock;
+
+using PawnCallback = std::function<bool( SafePtr<Pawn> )>;
+
+static double get_elapsed_ns( Clock::time_point start_time )
+{
+	return std::chrono::duration<double, std::nano>( Clock::now() - start_time ).count();
+}
+
+/*
+ * Spreads the query origins over the tiles of the world, the same for both forms.
+ */
+static std::vector<Vec3> make_origins( const World& world, int queries_count )
+{
+	const Box bounds = world.get_tile_bounds();
+	const int width = static_cast<int>( bounds.max.x - bounds.min.x ) + 1;
+	const int height = static_cast<int>( bounds.max.y - bounds.min.y ) + 1;
+
+	std::vector<Vec3> origins( static_cast<size_t>( queries_count ) );
+	for ( int i = 0; i < queries_count; i++ )
+	{
+		origins[i] = Vec3 {
+			bounds.min.x + static_cast<float>( i * 37 % width ),
+			bounds.min.y + static_cast<float>( i * 91 % height ),
+			0.0f
+		};
+	}
+	return origins;
+}
+
+/*
+ * Runs the query from each origin, checks the results match the reference if any, and
+ * returns the elapsed time in nanoseconds per unit of work.
+ */
+template <typename QueryType>
+static double bench_query( const std::vector<Vec3>& origins, int64_t units_count, QueryType&& query, std::vector<Pawn*>* results )
+{
+	std::vector<Pawn*> found_pawns( origins.size(), nullptr );
+
+	const Clock::time_point start_time = Clock::now();
+	for ( size_t i = 0; i < origins.size(); i++ )
+	{
+		found_pawns[i] = query( origins[i] ).get();
+	}
+	const double elapsed_ns = get_elapsed_ns( start_time );
+
+	if ( results->empty() )
+	{
+		*results = std::move( found_pawns );
+	}
+	else if ( *results != found_pawns )
+	{
+		return -1.0;
+	}
+
+	return elapsed_ns / static_cast<double>( std::max<int64_t>( units_count, 1 ) );
+}
+
+/*
+ * Compares the cost per candidate of the 'std::function' and templated overloads of the
+ * pawn queries on a populated world, checking both find the same pawns.
+ */
+int main( int arg_count, char** args )
+{
+	std::string scenario_path = "assets/ekosystem/data/scenarios/bench-10k.json";
+	int queries_count = 2000;
+	for ( int i = 1; i + 1 < arg_count; i += 2 )
+	{
+		const std::string_view arg = args[i];
+		if ( arg == "--scenario" )
+		{
+			scenario_path = args[i + 1];
+		}
+		else if ( arg == "--queries" )
+		{
+			queries_count = std::max( 1, atoi( args[i + 1] ) );
+		}
+	}
+
+	Engine& engine = Engine::instance();
+	JobSystem job_system( 1 );
+
+	World* world = load_scenario( scenario_path, &job_system );
+	if ( world == nullptr ) return 1;
+
+	const std::vector<Vec3> origins = make_origins( *world, queries_count );
+	const int64_t pawns_count = static_cast<int64_t>( world->get_pawns().size() );
+
+	//  Without any target data, every pawn is rejected and visited, so each query costs as many candidates as pawns
+	const PawnData* target_data = nullptr;
+	auto data_filter = [&]( const SafePtr<Pawn>& pawn ) { return pawn->data.get() == target_data; };
+	const PawnCallback data_callback = [&]( SafePtr<Pawn> pawn ) { return pawn->data.get() == target_data; };
+
+	//  NOTE: The callbacks are passed as 'std::function' lvalues so the non-template overloads are picked.
+	printf( "Querying %d times over %lld pawns of '%s'\n", queries_count, static_cast<long long>( pawns_count ), scenario_path.c_str() );
+
+	bool is_success = true;
+	const int64_t candidates_count = pawns_count * queries_count;
+	const auto print_row = [&]( const char* name, const char* unit, double function_ns, double template_ns )
+	{
+		if ( function_ns < 0.0 || template_ns < 0.0 )
+		{
+			printf( "  %-24s | ERROR: results differ between the overloads\n", name );
+			is_success = false;
+			return;
+		}
+
+		printf( "  %-24s | std::function: %8.2fns/%s | template: %8.2fns/%s | speedup: %5.2fx\n",
+			name, function_ns, unit, template_ns, unit, template_ns > 0.0 ? function_ns / template_ns : 0.0 );
+	};
+
+	{
+		std::vector<Pawn*> results {};
+		const double function_ns = bench_query( origins, candidates_count,
+			[&]( const Vec3& origin ) { return world->find_nearest_pawn( origin, data_callback ); }, &results );
+		const double template_ns = bench_query( origins, candidates_count,
+			[&]( const Vec3& origin ) { return world->find_nearest_pawn( origin, data_filter ); }, &results );
+		print_row( "find_nearest_pawn", "candidate", function_ns, template_ns );
+	}
+
+	{
+		std::vector<Pawn*> results {};
+		const double function_ns = bench_query( origins, candidates_count,
+			[&]( const Vec3& ) { return world->find_pawn( data_callback ); }, &results );
+		const double template_ns = bench_query( origins, candidates_count,
+			[&]( const Vec3& ) { return world->find_pawn( data_filter ); }, &results );
+		print_row( "find_pawn", "candidate", function_ns, template_ns );
+	}
+
+	//  Accepting the pawns of the rarest data stops the search early, checking both overloads still agree on the nearest one
+	{
+		size_t target_count = 0;
+		for ( const auto& [name, data] : world->get_pawn_datas() )
+		{
+			const size_t count = world->get_pawns_of( data.get() ).size();
+			if ( count == 0 || ( target_data != nullptr && count >= target_count ) ) continue;
+
+			target_data = data.get();
+			target_count = count;
+		}
+
+		std::vector<Pawn*> results {};
+		const double function_ns = bench_query( origins, queries_count,
+			[&]( const Vec3& origin ) { return world->find_nearest_pawn( origin, data_callback ); }, &results );
+		const double template_ns = bench_query( origins, queries_count,
+			[&]( const Vec3& origin ) { return world->find_nearest_pawn( origin, data_filter ); }, &results );
+		print_row( "find_nearest_pawn (hit)", "query", function_ns, template_ns );
+	}
+
+	delete world;
+
+	//  Release the pawns killed by the world's destruction
+	engine.update( 0.0f );
+
+	return is_success ? 0 : 1;
+}
@@ -0,0 +1,265 @@
+#include <suprengine/core/engine.h>
+#include <suprengine/core/assets.h>
+
+#include <ekosystem/entities/pawn.h>
+#include <ekosystem-headless/scenario.h>
+
+#include <chrono>
+#include <cstdint>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+using namespace suprengine;
+using namespace eks;
+
+//  Threads counts to compare, including the calling thread
+static constexpr int THREADS_COUNTS[] = { 1, 2, 4, 8, 16 };
+
+/*
+ * Settings of the benchmark, read from the command line.
+ */
+struct WorldBenchSettings
+{
+	//  Path to the scenario file, populated with over 10k pawns and seeded by default
+	std::string scenario_path = "assets/ekosystem/data/scenarios/bench-10k.json";
+	//  Number of fixed steps to simulate
+	int steps_count = 600;
+	//  Fixed delta time in seconds of each simulation step
+	float step = 1.0f / 60.0f;
+};
+
+/*
+ * World configuration each threads count is run with.
+ */
+struct WorldBenchConfig
+{
+	const char* name = "";
+	//  Whenever the pawns are ticked at the coarse rate of the far AI level of detail
+	bool is_ai_lod_enabled = false;
+	//  Maximum number of pawn ticks per update, deferring the pawns over it, 0 to disable
+	int ai_frame_budget_ticks = 0;
+	//  Number of fixed steps each update is given the time of
+	int steps_per_update = 1;
+	//  Whenever the food and threat queries are resolved in a batch sorted by grid cell before the ticks
+	bool is_query_batch_enabled = true;
+	//  Whenever the pawns are periodically re-sorted along a Z-order curve
+	bool is_morton_ordering_enabled = false;
+};
+
+static constexpr WorldBenchConfig CONFIGS[] = {
+	{ "default" },
+	//  Far tier without any focus, ticking each pawn every few steps
+	{ "ai lod", /* is_ai_lod_enabled */ true },
+	//  Under half of the pawns per update of 4 steps, deferring pawn ticks and carrying steps over
+	{ "ai budget", /* is_ai_lod_enabled */ false, /* ai_frame_budget_ticks */ 4096, /* steps_per_update */ 4 },
+	//  Compared against the default one to measure the gain of the query batch
+	{ "no query batch", /* is_ai_lod_enabled */ false, /* ai_frame_budget_ticks */ 0, /* steps_per_update */ 1, /* is_query_batch_enabled */ false },
+	{ "morton ordering", /* is_ai_lod_enabled */ false, /* ai_frame_budget_ticks */ 0, /* steps_per_update */ 1, /* is_query_batch_enabled */ true, /* is_morton_ordering_enabled */ true },
+};
+
+/*
+ * Outcome of a run, compared between the threads counts.
+ */
+struct WorldBenchResult
+{
+	double seconds = 0.0;
+	int64_t pawn_ticks_count = 0;
+	int cache_hits = 0;
+	int cache_queries = 0;
+	int64_t batched_queries_count = 0;
+
+	//  Population of each pawn data, in the order of the world's datas
+	std::vector<int> populations {};
+	//  Hash of the handle, state, tile position and hunger of each pawn, in the order of the world's list
+	uint64_t pawns_hash = 0;
+};
+
+static bool parse_settings( int arg_count, char** args, WorldBenchSettings* settings )
+{
+	for ( int i = 1; i + 1 < arg_count; i += 2 )
+	{
+		const std::string_view arg = args[i];
+		const char* value = args[i + 1];
+		try
+		{
+			if ( arg == "--scenario" )
+			{
+				settings->scenario_path = value;
+			}
+			else if ( arg == "--steps" )
+			{
+				settings->steps_count = std::stoi( value );
+			}
+			else if ( arg == "--step" )
+			{
+				settings->step = std::stof( value );
+			}
+			else
+			{
+				Logger::error( "Unknown option '%s'", args[i] );
+				return false;
+			}
+		}
+		catch ( const std::logic_error& )
+		{
+			Logger::error( "Invalid value '%s' for option '%s'", value, args[i] );
+			return false;
+		}
+	}
+
+	if ( settings->steps_count <= 0 || settings->step <= 0.0f )
+	{
+		Logger::error( "Steps count and step must be strictly positive" );
+		return false;
+	}
+
+	return true;
+}
+
+static uint64_t hash_bytes( uint64_t hash, const void* bytes, size_t size )
+{
+	const uint8_t* data = static_cast<const uint8_t*>( bytes );
+	for ( size_t i = 0; i < size; i++ )
+	{
+		hash ^= data[i];
+		hash *= 0x100000001b3ull;
+	}
+	return hash;
+}
+
+/*
+ * Simulates the scenario with the given configuration and threads count and collects its outcome.
+ * Returns false if the scenario can't be loaded.
+ */
+static bool run_world( const WorldBenchSettings& settings, const WorldBenchConfig& config, int threads_count, WorldBenchResult* result )
+{
+	Engine& engine = Engine::instance();
+	JobSystem job_system( threads_count );
+
+	World* world = load_scenario( settings.scenario_path, &job_system );
+	if ( world == nullptr ) return false;
+
+	world->fixed_timestep = settings.step;
+	world->is_ai_lod_enabled = config.is_ai_lod_enabled;
+	world->ai_frame_budget_ticks = config.ai_frame_budget_ticks;
+	world->is_query_batch_enabled = config.is_query_batch_enabled;
+	world->is_morton_ordering_enabled = config.is_morton_ordering_enabled;
+
+	using Clock = std::chrono::steady_clock;
+	const Clock::time_point start_time = Clock::now();
+
+	const float update_time = settings.step * config.steps_per_update;
+	for ( int step = 0; step < settings.steps_count; step += config.steps_per_update )
+	{
+		world->update( update_time );
+
+		//  Release the killed pawns, without the windowed loop
+		engine.update( update_time );
+	}
+
+	result->seconds = std::chrono::duration<double>( Clock::now() - start_time ).count();
+	result->pawn_ticks_count = world->get_pawn_ticks_count();
+	result->cache_hits = world->get_query_cache_hits();
+	result->cache_queries = result->cache_hits + world->get_query_cache_misses();
+	result->batched_queries_count = world->get_batched_queries_count();
+
+	for ( const auto& [name, data] : world->get_pawn_datas() )
+	{
+		result->populations.push_back( static_cast<int>( world->get_pawns_of( data.get() ).size() ) );
+	}
+
+	result->pawns_hash = 0xcbf29ce484222325ull;
+	for ( const SafePtr<Pawn>& pawn : world->get_pawns() )
+	{
+		const uint32_t handle = pawn->get_handle().value;
+		const int state_id = pawn->get_state_id();
+		result->pawns_hash = hash_bytes( result->pawns_hash, &handle, sizeof( handle ) );
+		result->pawns_hash = hash_bytes( result->pawns_hash, &state_id, sizeof( state_id ) );
+
+		const Vec3 tile_pos = pawn->get_tile_pos();
+		result->pawns_hash = hash_bytes( result->pawns_hash, &tile_pos.x, sizeof( tile_pos.x ) );
+		result->pawns_hash = hash_bytes( result->pawns_hash, &tile_pos.y, sizeof( tile_pos.y ) );
+		const float hunger = pawn->get_hunger();
+		result->pawns_hash = hash_bytes( result->pawns_hash, &hunger, sizeof( hunger ) );
+	}
+
+	delete world;
+
+	//  Release the pawns killed by the world's destruction
+	engine.update( 0.0f );
+	return true;
+}
+
+static bool is_same_result( const WorldBenchResult& lhs, const WorldBenchResult& rhs )
+{
+	return lhs.pawn_ticks_count == rhs.pawn_ticks_count
+		&& lhs.populations == rhs.populations
+		&& lhs.pawns_hash == rhs.pawns_hash;
+}
+
+/*
+ * Runs a seeded and populated world for a fixed number of steps with each configuration and threads
+ * count, reports the time spent per step, the pawn ticks throughput and the query cache efficiency,
+ * and checks the simulation ends up the same as with a single thread.
+ */
+int main( int arg_count, char** args )
+{
+	WorldBenchSettings settings {};
+	if ( !parse_settings( arg_count, args, &settings ) )
+	{
+		printf( "Usage: %s [--scenario <path>] [--steps <count>] [--step <seconds>]\n", args[0] );
+		return 1;
+	}
+
+	Assets::load_curves_in_folder(
+		"assets/ekosystem/curves/",
+		/* is_recursive */ true,
+		/* should_auto_reload */ false
+	);
+
+	printf( "Simulating '%s' for %d steps\n", settings.scenario_path.c_str(), settings.steps_count );
+
+	bool is_success = true;
+	for ( const WorldBenchConfig& config : CONFIGS )
+	{
+		printf( "Config '%s':\n", config.name );
+
+		WorldBenchResult reference {};
+		for ( int threads_count : THREADS_COUNTS )
+		{
+			WorldBenchResult result {};
+			if ( !run_world( settings, config, threads_count, &result ) ) return 1;
+
+			const double safe_seconds = result.seconds > 0.0 ? result.seconds : 1.0e-9;
+			printf( "  %2d threads | %7.3fms per step | %10.0f pawn ticks/s | query cache: %3d%% hits | %6lld batched queries/step\n",
+				threads_count,
+				result.seconds * 1000.0 / settings.steps_count,
+				result.pawn_ticks_count / safe_seconds,
+				result.cache_queries > 0 ? static_cast<int>( int64_t { result.cache_hits } * 100 / result.cache_queries ) : 0,
+				static_cast<long long>( result.batched_queries_count / settings.steps_count )
+			);
+
+			if ( threads_count == THREADS_COUNTS[0] )
+			{
+				reference = result;
+				continue;
+			}
+
+			if ( !is_same_result( result, reference ) )
+			{
+				printf( "  %2d threads | ERROR: simulation differs from the single thread one\n", threads_count );
+				is_success = false;
+			}
+		}
+
+		int pawns_count = 0;
+		for ( int population : reference.populations )
+		{
+			pawns_count += population;
+		}
+		printf( "  Final population: %d pawns\n", pawns_count );
+	}
+
+	return is_success ? 0 : 1;
+}
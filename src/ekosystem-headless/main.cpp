@@ -0,0 +1,200 @@
+#include <suprengine/core/engine.h>
+#include <suprengine/core/assets.h>
+
+#include <ekosystem/entities/pawn.h>
+
+#include "scenario.h"
+
+#include <algorithm>
+#include <chrono>
+#include <stdexcept>
+#include <string_view>
+
+using namespace suprengine;
+using namespace eks;
+
+/*
+ * Settings of a headless run, read from the command line.
+ */
+struct HeadlessSettings
+{
+	//  Path to the scenario file describing the world to simulate
+	std::string scenario_path = "assets/ekosystem/data/scenarios/default.json";
+	//  Amount of in-game hours to simulate
+	float hours = 24.0f;
+	//  Fixed delta time in seconds of each simulation step
+	float step = 1.0f / 60.0f;
+	//  Amount of in-game hours between each population report, 0 to disable
+	float report_interval = 1.0f;
+	//  Number of simulation threads, 0 to use all hardware threads
+	int threads_count = 0;
+	//  Whenever the pawns are ticked at the coarse rate of the far AI level of detail,
+	//  since there is no camera to focus on
+	bool is_ai_lod_enabled = true;
+};
+
+static void print_usage( const char* program_name )
+{
+	printf( "Usage: %s [--scenario <path>] [--hours <hours>] [--step <seconds>] [--report <hours>] [--threads <count>] [--ai-lod <on|off>]\n", program_name );
+}
+
+static bool parse_settings( int arg_count, char** args, HeadlessSettings* settings )
+{
+	for ( int i = 1; i < arg_count; i++ )
+	{
+		const std::string_view arg = args[i];
+		if ( arg == "--help" )
+		{
+			print_usage( args[0] );
+			return false;
+		}
+
+		//  All other options expect a value
+		if ( i + 1 >= arg_count )
+		{
+			Logger::error( "Missing value for option '%s'", args[i] );
+			return false;
+		}
+
+		const char* value = args[++i];
+		try
+		{
+			if ( arg == "--scenario" )
+			{
+				settings->scenario_path = value;
+			}
+			else if ( arg == "--hours" )
+			{
+				settings->hours = std::stof( value );
+			}
+			else if ( arg == "--step" )
+			{
+				settings->step = std::stof( value );
+			}
+			else if ( arg == "--report" )
+			{
+				settings->report_interval = std::stof( value );
+			}
+			else if ( arg == "--threads" )
+			{
+				settings->threads_count = std::stoi( value );
+			}
+			else if ( arg == "--ai-lod" )
+			{
+				settings->is_ai_lod_enabled = std::string_view( value ) != "off";
+			}
+			else
+			{
+				Logger::error( "Unknown option '%s'", args[i - 1] );
+				print_usage( args[0] );
+				return false;
+			}
+		}
+		//  Thrown by std::stof and std::stoi when the value is not a number or is out of range
+		catch ( const std::logic_error& )
+		{
+			Logger::error( "Invalid value '%s' for option '%s'", value, args[i - 1] );
+			print_usage( args[0] );
+			return false;
+		}
+	}
+
+	if ( settings->hours <= 0.0f || settings->step <= 0.0f )
+	{
+		Logger::error( "Hours and step must be strictly positive" );
+		return false;
+	}
+
+	return true;
+}
+
+static void print_population( const World* world, float hours )
+{
+	printf( "[%7.2fh] %6d pawns |", hours, static_cast<int>( world->get_pawns().size() ) );
+	for ( const auto& [name, data] : world->get_pawn_datas() )
+	{
+		printf( " %s: %d", name.c_str(), static_cast<int>( world->get_pawns_of( data.get() ).size() ) );
+	}
+	printf( "\n" );
+}
+
+/*
+ * Runs a world for a given amount of in-game hours as fast as possible, without any window,
+ * rendering or debug menu, and prints the throughput and the population along the way.
+ */
+int main( int arg_count, char** args )
+{
+	HeadlessSettings settings {};
+	if ( !parse_settings( arg_count, args, &settings ) ) return 1;
+
+	Engine& engine = Engine::instance();
+
+	//  Only curves are needed by the simulation, models and textures are never loaded
+	Assets::load_curves_in_folder(
+		"assets/ekosystem/curves/",
+		/* is_recursive */ true,
+		/* should_auto_reload */ false
+	);
+
+	JobSystem job_system( settings.threads_count );
+
+	World* world = load_scenario( settings.scenario_path, &job_system );
+	if ( world == nullptr ) return 1;
+
+	//  Run exactly one fixed step per update
+	world->fixed_timestep = settings.step;
+	world->is_ai_lod_enabled = settings.is_ai_lod_enabled;
+
+	printf(
+		"Simulating '%s' for %.2f hours with a step of %.4fs on %d threads (AI LOD %s)\n",
+		settings.scenario_path.c_str(), settings.hours, settings.step, job_system.get_threads_count(),
+		settings.is_ai_lod_enabled ? "on" : "off"
+	);
+	print_population( world, 0.0f );
+
+	using Clock = std::chrono::steady_clock;
+	const Clock::time_point start_time = Clock::now();
+
+	float hours = 0.0f;
+	float next_report_hours = settings.report_interval;
+	int64_t ticks_count = 0;
+	size_t peak_pawns_count = world->get_pawns().size();
+	while ( hours < settings.hours && !world->get_pawns().empty() )
+	{
+		world->update( settings.step );
+
+		//  Release the killed pawns, without the windowed loop
+		engine.update( settings.step );
+
+		hours += settings.step * world->world_time_scale;
+		ticks_count++;
+		peak_pawns_count = std::max( peak_pawns_count, world->get_pawns().size() );
+
+		if ( settings.report_interval > 0.0f && hours >= next_report_hours )
+		{
+			print_population( world, hours );
+			next_report_hours += settings.report_interval;
+		}
+	}
+
+	const double seconds = std::chrono::duration<double>( Clock::now() - start_time ).count();
+	const double safe_seconds = seconds > 0.0 ? seconds : 1.0e-9;
+
+	printf( "\n" );
+	if ( world->get_pawns().empty() )
+	{
+		printf( "Extinction after %.2f hours\n", hours );
+	}
+	print_population( world, hours );
+	printf( "Peak population: %d pawns\n", static_cast<int>( peak_pawns_count ) );
+	printf( "Elapsed: %.3fs for %lld ticks\n", seconds, static_cast<long long>( ticks_count ) );
+	//  Only count the pawn ticks which actually ran, the AI level of detail skips most of them
+	printf( "Throughput: %.1f ticks/s, %.2f hours/s, %.0f pawn ticks/s\n",
+		ticks_count / safe_seconds,
+		hours / safe_seconds,
+		world->get_pawn_ticks_count() / safe_seconds
+	);
+
+	delete world;
+	return 0;
+}
@@ -0,0 +1,82 @@
+#include "scenario.h"
+
+#include <suprengine/utils/json.h>
+
+#include <ekosystem/entities/pawn.h>
+
+#include <fstream>
+
+using namespace eks;
+
+World* eks::load_scenario( const std::string& path, JobSystem* job_system )
+{
+	std::ifstream file( path );
+	if ( !file.is_open() )
+	{
+		Logger::error( "Failed to open scenario at '%s'", path.c_str() );
+		return nullptr;
+	}
+
+	//  Read file contents
+	std::string content(
+		( std::istreambuf_iterator<char>( file ) ),
+		( std::istreambuf_iterator<char>() )
+	);
+	file.close();
+
+	//  Parse contents into JSON
+	json::document doc {};
+	doc.Parse( content.c_str() );
+	if ( doc.HasParseError() || !doc.IsObject() )
+	{
+		Logger::error( "Failed to parse scenario at '%s'", path.c_str() );
+		return nullptr;
+	}
+
+	const Vec2 size {
+		json::get( doc, "width", 20.0f ),
+		json::get( doc, "height", 20.0f ),
+	};
+	World* world = new World( size, job_system );
+
+	//  Seed the simulation before spawning the pawns, so runs of the scenario can be compared
+	if ( doc.HasMember( "seed" ) )
+	{
+		world->set_random_seed( doc["seed"].GetUint() );
+	}
+
+	if ( doc.HasMember( "group_limits" ) )
+	{
+		for ( const auto& group_limit : doc["group_limits"].GetArray() )
+		{
+			world->set_group_limit(
+				static_cast<GroupID>( group_limit["group_id"].GetUint() ),
+				static_cast<uint8>( group_limit["limit"].GetUint() )
+			);
+		}
+	}
+
+	if ( doc.HasMember( "pawns" ) )
+	{
+		for ( const auto& spawn : doc["pawns"].GetArray() )
+		{
+			const std::string data_name = spawn["data"].GetString();
+			SafePtr<PawnData> data = world->get_pawn_data( data_name );
+			if ( !data.is_valid() )
+			{
+				Logger::error( "Unknown pawn data '%s' in scenario, skipping it", data_name.c_str() );
+				continue;
+			}
+
+			const int count = spawn["count"].GetInt();
+			const GroupID group_id = spawn.HasMember( "group_id" ) ? static_cast<GroupID>( spawn["group_id"].GetUint() ) : 0;
+			for ( int i = 0; i < count; i++ )
+			{
+				auto pawn = world->create_pawn( data, world->find_random_tile_pos() );
+				pawn->set_group_id( group_id );
+			}
+		}
+	}
+
+	return world;
+}
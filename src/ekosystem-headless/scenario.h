@@ -0,0 +1,14 @@
+#pragma once
+
+#include <ekosystem/world.h>
+
+#include <string>
+
+namespace eks
+{
+	/*
+	 * Creates the world described by the scenario file: its size, random seed, group limits and initial pawns.
+	 * Returns nullptr if the file can't be read.
+	 */
+	World* load_scenario( const std::string& path, JobSystem* job_system );
+}
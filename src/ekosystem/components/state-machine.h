@@ -353,25 +353,9 @@ namespace eks
 		}
 		virtual void update( float dt ) override
 		{
-			auto next_state = _current_state;
-			if ( _current_state == nullptr || _current_state->can_switch_from() )
-			{
-				next_state = nullptr;
-
-				//	Select the first runnable state
-				//	NOTE: This code prevents manual user control over the state
-				//		  that should run. An enum indicating the state machine
-				//		  mode could help to choose between manual and automatic
-				//		  modes, but that's not what I need right now.
-				for ( int i = 0; i < _states.size(); i++ )
-				{
-					auto state = _states[i];
-					if ( !state->can_switch_to() ) continue;
-		
-					next_state = state;
-					break;
-				}
-			}
+			//	Use the state decided beforehand, if any
+			auto next_state = _has_decided_state ? _decided_state : find_next_state();
+			discard_decided_state();
 
 			//	Switch to the next state
 			if ( next_state != _current_state )
@@ -416,6 +400,49 @@ namespace eks
 			}
 		}
 
+		/*
+		 * Returns the state to run at the next update: the current one if it can't be
+		 * switched from, the first runnable state otherwise.
+		 * It only evaluates the states, without switching to the found one.
+		 */
+		State<OwnerType>* find_next_state() const
+		{
+			if ( _current_state != nullptr && !_current_state->can_switch_from() ) return _current_state;
+
+			//	Select the first runnable state
+			//	NOTE: This code prevents manual user control over the state
+			//		  that should run. An enum indicating the state machine
+			//		  mode could help to choose between manual and automatic
+			//		  modes, but that's not what I need right now.
+			for ( int i = 0; i < _states.size(); i++ )
+			{
+				auto state = _states[i];
+				if ( !state->can_switch_to() ) continue;
+
+				return state;
+			}
+
+			return nullptr;
+		}
+		/*
+		 * Finds the state to run and keeps it for the next update instead of evaluating
+		 * the states during it. This allows the owners to evaluate their states in parallel,
+		 * as long as the states only read the world, and to update them one at a time.
+		 */
+		void decide_next_state()
+		{
+			_decided_state = find_next_state();
+			_has_decided_state = true;
+		}
+		/*
+		 * Forgets the state kept by decide_next_state, the next update evaluates the states itself.
+		 */
+		void discard_decided_state()
+		{
+			_decided_state = nullptr;
+			_has_decided_state = false;
+		}
+
 		/*
 		 * Creates a state that the machine owns and inserts it in its vector of states.
 		 * Returns the created state.
@@ -439,6 +466,9 @@ namespace eks
 		 */
 		void switch_state( State<OwnerType>* state )
 		{
+			//	Any decision was made for the previous state
+			discard_decided_state();
+
 			if ( _current_state != nullptr )
 			{
 				_current_state->on_end();
@@ -457,6 +487,16 @@ namespace eks
 
 			_current_state = state;
 
+			//	Keep the index of the state for the owners storing it
+			_current_state_id = -1;
+			for ( int i = 0; i < _states.size(); i++ )
+			{
+				if ( _states[i] != state ) continue;
+
+				_current_state_id = i;
+				break;
+			}
+
 			if ( _current_state != nullptr )
 			{
 				_current_state->on_begin();
@@ -467,6 +507,13 @@ namespace eks
 		{
 			return _current_state;
 		}
+		/*
+		 * Returns the index of the current state inside the vector of states, -1 without any.
+		 */
+		int get_current_state_id() const
+		{
+			return _current_state_id;
+		}
 		const std::vector<State<OwnerType>*>& get_states() const
 		{
 			return _states;
@@ -477,6 +524,11 @@ namespace eks
 
 	private:
 		State<OwnerType>* _current_state = nullptr;
+		int _current_state_id = -1;
 		std::vector<State<OwnerType>*> _states {};
+
+		//	State found by decide_next_state, used by the next update
+		State<OwnerType>* _decided_state = nullptr;
+		bool _has_decided_state = false;
 	};
 }
\ No newline at end of file
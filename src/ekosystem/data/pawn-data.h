@@ -38,6 +38,9 @@ namespace eks
 	};
 	DEFINE_ENUM_WITH_FLAGS( Adjectives, uint32_t )
 
+	//  Number of single-bit adjectives, from Photosynthesis to Vegetal
+	constexpr int ADJECTIVES_COUNT = 5;
+
 	struct PawnData
 	{
 	public:
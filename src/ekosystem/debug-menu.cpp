@@ -8,6 +8,7 @@
 
 #include <array>
 #include <filesystem>
+#include <thread>
 
 using namespace eks;
 
@@ -435,6 +436,112 @@ void DebugMenu::populate()
 
 		ImGui::DragFloat( "Hunger when Sleeping Modifier", &world->pawn_hunger_sleep_modifier, 0.01f, 0.0f, 2.0f, "x%.2f" );
 
+		//	Fixed timestep
+		float fixed_timestep_ms = world->fixed_timestep * 1000.0f;
+		if ( ImGui::DragFloat( "Fixed Timestep", &fixed_timestep_ms, 0.1f, 1.0f, 100.0f, "%.2fms" ) )
+		{
+			world->fixed_timestep = math::max( fixed_timestep_ms, 1.0f ) / 1000.0f;
+		}
+		ImGui::SetItemTooltip( "Simulated time of each world step, independent from the frame rate" );
+		ImGui::DragInt( "Max Fixed Steps per Update", &world->max_fixed_steps_per_update, 1.0f, 1, 1024 );
+		ImGui::DragInt( "Max Pawn Ticks per Update", &world->max_pawn_ticks_per_update, 100.0f, 0, 1000000 );
+		ImGui::SetItemTooltip( "Lowers the fixed steps of crowded worlds to bound the frame time, 0 to disable" );
+		ImGui::Text( "Fixed Steps: %d this frame (tick %d)", world->get_fixed_steps_count(), world->get_tick() );
+
+		//	Job system
+		if ( JobSystem* job_system = world->get_job_system() )
+		{
+			int threads_count = job_system->get_threads_count();
+			const int max_threads_count = math::max( 1, static_cast<int>( std::thread::hardware_concurrency() ) );
+			if ( ImGui::SliderInt( "Job Threads", &threads_count, 1, max_threads_count ) )
+			{
+				job_system->set_threads_count( threads_count );
+			}
+			ImGui::SetItemTooltip( "Threads of the job system ticking the pawns needs and resolving the queries" );
+		}
+
+		//	Query batch & cache
+		ImGui::Checkbox( "Query Batch", &world->is_query_batch_enabled );
+		ImGui::SetItemTooltip( "Resolve the food and threat queries in a batch sorted by grid cell before ticking the pawns" );
+		ImGui::DragInt( "Query Cache Staleness", &world->query_cache_staleness_ticks, 0.1f, 0, 60, "%d ticks" );
+		ImGui::SetItemTooltip( "Number of ticks a cached food or threat query is re-used for" );
+		const int cache_hits = world->get_query_cache_hits();
+		const int cache_misses = world->get_query_cache_misses();
+		const int cache_queries = cache_hits + cache_misses;
+		ImGui::Text(
+			"Query Cache: %d hits / %d misses (%03d%%)",
+			cache_hits, cache_misses,
+			cache_queries > 0 ? cache_hits * 100 / cache_queries : 0
+		);
+		ImGui::SameLine();
+		if ( ImGui::SmallButton( "Reset##QueryCache" ) )
+		{
+			world->reset_query_cache_stats();
+		}
+
+		//	Morton ordering
+		ImGui::Checkbox( "Morton Ordering", &world->is_morton_ordering_enabled );
+		ImGui::SetItemTooltip( "Periodically re-sort the pawns and their hot state along a Z-order curve for cache-local ticks" );
+		if ( world->is_morton_ordering_enabled )
+		{
+			ImGui::DragInt( "Morton Ordering Interval", &world->morton_ordering_interval_ticks, 1.0f, 1, 600, "%d ticks" );
+		}
+
+		//	Chunks
+		ImGui::Checkbox( "Chunk Dormancy", &world->is_chunk_dormancy_enabled );
+		ImGui::SetItemTooltip( "Only advance chunks without mobile pawns by coarse updates" );
+		ImGui::SameLine();
+		ImGui::Text( "%d/%d dormant chunks", world->get_dormant_chunks_count(), world->get_chunks_count() );
+		if ( world->is_chunk_dormancy_enabled )
+		{
+			ImGui::DragFloat( "Dormant Chunk Update Period", &world->dormant_chunk_update_period, 0.01f, 0.0f, 5.0f, "%.2fs" );
+		}
+
+		//	Timer wheel
+		ImGui::Checkbox( "Timer Wheel", &world->is_timer_wheel_enabled );
+		ImGui::SetItemTooltip( "Suspend the state machine of waiting pawns, e.g. sleeping, until their wake time" );
+		ImGui::SameLine();
+		ImGui::Text( "%d/%d suspended pawns", world->get_suspended_pawns_count(), static_cast<int>( pawns.size() ) );
+		if ( world->is_timer_wheel_enabled )
+		{
+			ImGui::DragFloat( "Threat Wake Radius", &world->threat_wake_radius, 0.1f, 0.0f, 16.0f, "%.1f tiles" );
+		}
+
+		//	AI level of detail
+		ImGui::Checkbox( "AI LOD", &world->is_ai_lod_enabled );
+		ImGui::SetItemTooltip( "Tick the pawns far from the camera every few steps, with their accumulated time" );
+		ImGui::SameLine();
+		ImGui::Text(
+			"%d near / %d medium / %d far",
+			world->get_pawns_count_in_ai_lod( PawnAILod::Near ),
+			world->get_pawns_count_in_ai_lod( PawnAILod::Medium ),
+			world->get_pawns_count_in_ai_lod( PawnAILod::Far )
+		);
+		if ( world->is_ai_lod_enabled )
+		{
+			ImGui::DragFloat2( "AI LOD Distances", world->ai_lod_distances, 0.1f, 0.0f, 256.0f, "%.1f tiles" );
+			ImGui::SetItemTooltip( "Maximum distances to the camera focus of the near and medium tiers" );
+			ImGui::DragInt3( "AI LOD Tick Intervals", world->ai_lod_tick_intervals, 0.1f, 1, 120, "%d steps" );
+			ImGui::SetItemTooltip( "Number of fixed steps between two ticks of a pawn, for the near, medium and far tiers" );
+		}
+
+		//	AI frame budget
+		ImGui::DragInt( "AI Frame Budget", &world->ai_frame_budget_us, 10.0f, 0, 100000, "%dus" );
+		ImGui::SetItemTooltip( "Maximum time spent running the fixed steps per frame, 0 to disable. Makes the simulation depend on the machine speed" );
+		ImGui::DragInt( "AI Frame Budget Ticks", &world->ai_frame_budget_ticks, 10.0f, 0, 1000000, "%d pawns" );
+		ImGui::SetItemTooltip( "Maximum number of pawn ticks per frame, 0 to disable. Keeps the simulation deterministic" );
+		if ( world->ai_frame_budget_us > 0 || world->ai_frame_budget_ticks > 0 )
+		{
+			ImGui::DragFloat( "Max AI Backlog Time", &world->max_ai_backlog_time, 0.01f, 0.0f, 5.0f, "%.2fs" );
+			ImGui::SetItemTooltip( "Maximum simulated time the fixed steps can fall behind when stopped by the budget" );
+			ImGui::Text(
+				"AI Budget: %.0f/%dus (%03d%%) | Backlog: %d pawns, %.2fs behind",
+				world->get_ai_budget_spent_us(), world->ai_frame_budget_us,
+				static_cast<int>( world->get_ai_budget_spent_us() * 100.0f / math::max( world->ai_frame_budget_us, 1 ) ),
+				world->get_ai_backlog_count(), world->get_ai_lag()
+			);
+		}
+
 		ImGui::Spacing();
 
 		_populate_pawns_table( pawns );
@@ -695,9 +802,10 @@ void DebugMenu::populate()
 			if ( ImGui::BeginTable( "adjectives", 3, ImGuiTableFlags_None ) )
 			{
 				auto adjectives = reinterpret_cast<uint32*>( &data->adjectives );
+				bool has_changed = false;
 
 				ImGui::TableNextColumn();
-				ImGui::CheckboxFlags(
+				has_changed |= ImGui::CheckboxFlags(
 					"Photosynthesis",
 					adjectives,
 					static_cast<uint32>( Adjectives::Photosynthesis )
@@ -705,7 +813,7 @@ void DebugMenu::populate()
 				ImGui::SetItemTooltip( "Consume light as food" );
 
 				ImGui::TableNextColumn();
-				ImGui::CheckboxFlags(
+				has_changed |= ImGui::CheckboxFlags(
 					"Carnivore",
 					adjectives,
 					static_cast<uint32>( Adjectives::Carnivore )
@@ -713,7 +821,7 @@ void DebugMenu::populate()
 				ImGui::SetItemTooltip( "Consume Meat as food" );
 
 				ImGui::TableNextColumn();
-				ImGui::CheckboxFlags(
+				has_changed |= ImGui::CheckboxFlags(
 					"Herbivore",
 					adjectives,
 					static_cast<uint32>( Adjectives::Herbivore )
@@ -721,7 +829,7 @@ void DebugMenu::populate()
 				ImGui::SetItemTooltip( "Consume Vegetal as food" );
 
 				ImGui::TableNextColumn();
-				ImGui::CheckboxFlags(
+				has_changed |= ImGui::CheckboxFlags(
 					"Meat",
 					adjectives,
 					static_cast<uint32>( Adjectives::Meat )
@@ -729,13 +837,18 @@ void DebugMenu::populate()
 				ImGui::SetItemTooltip( "Is eatable by Carnivore" );
 
 				ImGui::TableNextColumn();
-				ImGui::CheckboxFlags(
+				has_changed |= ImGui::CheckboxFlags(
 					"Vegetal",
 					adjectives,
 					static_cast<uint32>( Adjectives::Vegetal )
 				);
 				ImGui::SetItemTooltip( "Is eatable by Herbivore" );
 
+				if ( has_changed )
+				{
+					world->refresh_pawn_data_adjectives( data.get() );
+				}
+
 				ImGui::EndTable();
 			}
 
@@ -793,11 +906,11 @@ void DebugMenu::update_histogram()
 SharedPtr<Pawn> DebugMenu::create_pawn( SafePtr<PawnData> data, const Vec3& pos )
 {
 	auto pawn = world->create_pawn( data, pos );
-	pawn->group_id = _group_id;
+	pawn->set_group_id( _group_id );
 	
 	if ( _is_overriding_hunger )
 	{
-		pawn->hunger = _hunger_ratio * data->max_hunger;
+		pawn->set_hunger( _hunger_ratio * data->max_hunger );
 	}
 	
 	return pawn;
@@ -866,7 +979,8 @@ void DebugMenu::_populate_pawns_table(
 			| ImGuiSelectableFlags_AllowOverlap;
 		for ( int i = 0; i < pawns.size(); i++ )
 		{
-			auto& pawn = pawns[i];
+			//  Copy since killing the pawn removes it from the list
+			SafePtr<Pawn> pawn = pawns[i];
 			if ( !pawn.is_valid() ) continue;
 
 			if ( should_filter_grass && pawn->data->name == "grass" ) continue;
@@ -903,7 +1017,7 @@ void DebugMenu::_populate_pawns_table(
 			//  Column 3: Hunger
 			ImGui::TableSetColumnIndex( 3 );
 			float hunger_ratio = math::clamp(
-				pawn->hunger / pawn->data->max_hunger,
+				pawn->get_hunger() / pawn->data->max_hunger,
 				0.0f, 1.0f
 			);
 			ImGui::Extra::ColoredProgressBar(
@@ -920,9 +1034,10 @@ void DebugMenu::_populate_pawns_table(
 
 	if ( ImGui::Button( "Purge" ) )
 	{
-		for ( auto& pawn : pawns )
+		//  Backward since killed pawns are replaced by the last one
+		for ( int i = static_cast<int>( pawns.size() ) - 1; i >= 0; i-- )
 		{
-			pawn->kill();
+			pawns[i]->kill();
 		}
 	}
 	ImGui::SetItemTooltip( "Kill all existing pawns" );
@@ -1013,7 +1128,7 @@ void DebugMenu::_populate_selected_pawn( const std::vector<SafePtr<Pawn>>& pawns
 	ImGui::Text( "Name: %s", *pawn->get_name() );
 
 	//  Compute hunger
-	float hunger = pawn->hunger;
+	float hunger = pawn->get_hunger();
 	float max_hunger = pawn->data->max_hunger;
 	float hunger_ratio = math::clamp(
 		hunger / max_hunger,
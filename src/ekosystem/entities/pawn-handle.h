@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstdint>
+
+namespace eks
+{
+	/*
+	 * Compact reference to a pawn, packing the index of its slot inside the world with
+	 * the generation of this slot. A slot's generation changes when its pawn is removed,
+	 * so stale handles are detected by a single comparison, without reference counting.
+	 *
+	 * Resolved by World::get_pawn.
+	 */
+	struct PawnHandle
+	{
+	public:
+		static constexpr uint32_t INDEX_BITS = 20;
+		static constexpr uint32_t INDEX_MASK = ( 1u << INDEX_BITS ) - 1;
+		static constexpr uint32_t GENERATION_MASK = 0xFFFFFFFFu >> INDEX_BITS;
+
+	public:
+		PawnHandle() = default;
+		PawnHandle( uint32_t index, uint32_t generation )
+			: value( ( generation & GENERATION_MASK ) << INDEX_BITS | ( index & INDEX_MASK ) )
+		{}
+
+		uint32_t get_index() const { return value & INDEX_MASK; }
+		uint32_t get_generation() const { return value >> INDEX_BITS; }
+
+		/*
+		 * Returns whenever the handle references no pawn at all.
+		 * Slots never use the zero generation so null handles are never resolved.
+		 */
+		bool is_null() const { return value == 0; }
+
+		bool operator==( const PawnHandle& other ) const { return value == other.value; }
+		bool operator!=( const PawnHandle& other ) const { return value != other.value; }
+
+	public:
+		uint32_t value = 0;
+	};
+}
@@ -2,9 +2,10 @@
 
 #include <suprengine/core/engine.h>
 #include <suprengine/core/assets.h>
-#include <suprengine/utils/random.h>
 
+#ifndef EKOSYSTEM_HEADLESS
 #include <ekosystem/components/particle-renderer.h>
+#endif
 
 #include "states/pawn-flee.h"
 #include "states/pawn-chase.h"
@@ -17,11 +18,12 @@ using namespace eks;
 Pawn::Pawn( World* world, SafePtr<PawnData> data )
 	: _world( world ), data( data ), _name( data->name + "#" + std::to_string( get_unique_id() ) )
 {
-	hunger = data->hunger_at_spawn;
+	_hunger = data->hunger_at_spawn;
 }
 
 void Pawn::setup()
 {
+#ifndef EKOSYSTEM_HEADLESS
 	auto model = Assets::get_model( data->model_name );
 
 	_renderer = create_component<ModelRenderer>( 
@@ -29,9 +31,11 @@ void Pawn::setup()
 		data->shader_name,
 		data->modulate
 	);
+#endif
 
 	if ( data->move_speed > 0.0f )
 	{
+	#ifndef EKOSYSTEM_HEADLESS
 		_sleep_particle_renderer = create_component<ParticleRenderer>();
 		_sleep_particle_renderer->is_spawning = false;
 		_sleep_particle_renderer->system_data = data->sleep_particle_system;
@@ -39,6 +43,7 @@ void Pawn::setup()
 		_love_particle_renderer = create_component<ParticleRenderer>();
 		_love_particle_renderer->is_spawning = false;
 		_love_particle_renderer->system_data = data->love_particle_system;
+	#endif
 
 		//	Do not create a state machine for pawns with no ability to move.
 		//	It greatly helps to optimize memory usage and CPU time (e.g. I have
@@ -56,6 +61,7 @@ void Pawn::setup()
 
 void Pawn::update_this( float dt )
 {
+#ifndef EKOSYSTEM_HEADLESS
 	//  TODO: Debug build only
 	_renderer->modulate = data->modulate;
 
@@ -70,30 +76,21 @@ void Pawn::update_this( float dt )
 		);
 	}
 
-	if ( dt > 0.0f )
+	//	The simulation is ticked by the world, only interpolate the transform
+	//	between its last two fixed steps
+	if ( _is_transform_interpolated )
 	{
-		//  Substepping tick
-		//  NOTE: It fixes issues in behaviors when the time scale is 
-		//	really high (e.g. time scale set to 32). Reproduction could
-		//  not happen if the threshold was too thin.
-		auto& engine = Engine::instance();
-		int substeps = (int)math::ceil( engine.get_updater()->time_scale );
-		float subdelta = dt / substeps;
-		for ( int substep = 0; substep < substeps; substep++ )
-		{
-			tick( subdelta );
-		}
+		const float alpha = _world->get_fixed_step_alpha();
+		transform->set_location( Vec3::lerp( _previous_transform.location, _simulated_transform.location, alpha ) );
+		transform->set_rotation( Quaternion::slerp( _previous_transform.rotation, _simulated_transform.rotation, alpha ) );
+		transform->set_scale( Vec3::lerp( _previous_transform.scale, _simulated_transform.scale, alpha ) );
 	}
+#endif
 }
 
-void Pawn::tick( float dt )
+void Pawn::tick_needs( float dt )
 {
-	//	Manually update the state machine using the substepping tick
-	//	of the pawn
-	if ( _state_machine != nullptr )
-	{
-		_state_machine->update( dt );
-	}
+	float hunger = get_hunger();
 
 	//  Hunger gain
 	float hunger_modifier = is_sleeping ? _world->pawn_hunger_sleep_modifier : 1.0f;
@@ -112,32 +109,108 @@ void Pawn::tick( float dt )
 			hunger + data->photosynthesis_gain * _world->get_photosynthesis_multiplier() * dt,
 			data->max_hunger
 		);
+	}
+
+	set_hunger( hunger );
+}
+
+void Pawn::tick_decisions()
+{
+	if ( _state_machine == nullptr ) return;
+
+	//	Suspended pawns don't update their state machine during the actions tick
+	if ( is_suspended() )
+	{
+		_state_machine->discard_decided_state();
+		return;
+	}
+
+	_state_machine->decide_next_state();
+}
+
+void Pawn::tick_actions( float dt )
+{
+	//	Manually update the state machine using the fixed step
+	//	of the world
+	if ( _state_machine != nullptr )
+	{
+		if ( is_suspended() )
+		{
+			_suspended_time += dt;
+		}
+		else
+		{
+			//	Catch up the time elapsed while suspended in a single update
+			_state_machine->update( dt + _suspended_time );
+			_suspended_time = 0.0f;
+		}
+
+		_set_state_id( _state_machine->get_current_state_id() );
+	}
+
+	//	Manual reproduction for photosynthesis pawns without a state machine
+	if ( _state_machine == nullptr
+	  && data->has_adjective( Adjectives::Photosynthesis )
+	  && get_hunger() >= data->min_hunger_for_reproduction )
+	{
+		reproduce( nullptr );
+	}
+
+	//  Kill from hunger
+	if ( get_hunger() <= 0.0f )
+	{
+		kill();
+	}
+}
+
+void Pawn::coarse_tick( float dt )
+{
+	//  Hunger gain
+	set_hunger( math::max( get_hunger() - data->natural_hunger_consumption * dt, 0.0f ) );
+
+	//  Photosynthesis
+	if ( data->has_adjective( Adjectives::Photosynthesis ) )
+	{
+		set_hunger(
+			math::min(
+				get_hunger() + data->photosynthesis_gain * _world->get_photosynthesis_multiplier() * dt,
+				data->max_hunger
+			)
+		);
 
 		//	Manual reproduction for photosynthesis pawns without a state machine
-		if ( _state_machine == nullptr && hunger >= data->min_hunger_for_reproduction )
+		if ( _state_machine == nullptr && get_hunger() >= data->min_hunger_for_reproduction )
 		{
 			reproduce( nullptr );
 		}
 	}
 
 	//  Kill from hunger
-	if ( hunger <= 0.0f )
+	if ( get_hunger() <= 0.0f )
 	{
 		kill();
 	}
 }
 
-void Pawn::reproduce( SafePtr<Pawn> partner )
+void Pawn::reproduce( Pawn* partner )
 {
+	//	The partner already mated with this pawn during this tick
+	if ( partner != nullptr && partner->partner_pawn != _handle )
+	{
+		partner_pawn = PawnHandle {};
+		return;
+	}
+
 	//	Get the number of children to born
-	int child_spawn_count = random::generate( data->min_child_spawn_count, data->max_child_spawn_count );
+	int child_spawn_count = _world->generate_random( data->min_child_spawn_count, data->max_child_spawn_count );
 
 	//	Prevent from giving birth to a number of children that it exceeds the population limit
 	const World* world = get_world();
-	const int population_limit = world->get_group_limit( group_id );
+	const int population_limit = world->get_group_limit( _group_id );
 	if ( population_limit > 0 )
 	{
-		const int current_population = world->get_pawns_count_in_group( group_id );
+		const int current_population = world->get_pawns_count_in_group( _group_id )
+									 + world->get_pending_births_count_in_group( _group_id );
 		if ( current_population + child_spawn_count > population_limit )
 		{
 			child_spawn_count = population_limit - current_population;
@@ -146,71 +219,165 @@ void Pawn::reproduce( SafePtr<Pawn> partner )
 
 	if ( child_spawn_count <= 0 ) return;
 
-	//	Generate children around
+	//	Queue the children to be born around at the end of the tick
 	//	NOTE: We only want animals to be able to spawn on vegetal.
-	const Adjectives empty_adjectives_filter = data->has_adjective( Adjectives::Vegetal )
-											 ? Adjectives::None
-											 : Adjectives::Vegetal;
-	Vec3 spawn_pos;
-	int spawned_children_count = 0;
-	for ( int i = 0; i < child_spawn_count; i++ )
-	{
-		if ( !_world->find_empty_tile_pos_around( _tile_pos, &spawn_pos, empty_adjectives_filter ) ) continue;
-
-		auto child = _world->create_pawn( data, spawn_pos );
-		child->group_id = group_id;
-		spawned_children_count++;
-	}
+	_world->enqueue_birth(
+		PawnBirth {
+			.data = data,
+			.parent_tile_pos = get_tile_pos(),
+			.group_id = _group_id,
+			.adjectives_filter = data->has_adjective( Adjectives::Vegetal )
+							   ? Adjectives::None
+							   : Adjectives::Vegetal,
+			.children_count = child_spawn_count,
+		}
+	);
 
 	//	Consume hunger
-	hunger -= data->hunger_consumption_on_reproduction;
-	partner_pawn = nullptr;
+	set_hunger( get_hunger() - data->hunger_consumption_on_reproduction );
+	partner_pawn = PawnHandle {};
 
-	//	Consume partner's hunger
-	if ( partner.is_valid() )
+	//	Consume partner's hunger, keeping it untouched until the end of the tick
+	if ( partner != nullptr )
 	{
-		partner->hunger -= partner->data->hunger_consumption_on_reproduction;
-		partner->partner_pawn = nullptr;
+		_world->enqueue_command(
+			PawnCommand {
+				.type = PawnCommandType::HungerDelta,
+				.target = partner->get_handle(),
+				.amount = -partner->data->hunger_consumption_on_reproduction,
+			}
+		);
+		_world->enqueue_command(
+			PawnCommand {
+				.type = PawnCommandType::PartnerLink,
+				.target = partner->get_handle(),
+			}
+		);
 		Logger::info(
-			"%s gave birth to %d/%d children by mating with %s.",
+			"%s mated with %s.",
 			*get_name(),
-			spawned_children_count, child_spawn_count,
 			*partner->get_name()
 		);
 	}
 
+#ifndef EKOSYSTEM_HEADLESS
 	//	Spawn love particles
 	if ( _love_particle_renderer != nullptr )
 	{
 		_love_particle_renderer->spawn_particles();
 	}
+#endif
 }
 
 void Pawn::set_tile_pos( const Vec3& tile_pos )
 {
+	//	Teleport outside of the fixed steps, discarding the interpolation
+	_is_transform_interpolated = false;
+
 	transform->location = tile_pos * _world->TILE_SIZE;
 	update_tile_pos();
+
+	//	Start both interpolated transforms at the new location, so pawns spawned
+	//	during the last fixed step don't fly in from their default transform
+	_previous_transform = _capture_transform();
+	_simulated_transform = _previous_transform;
 }
 
 void Pawn::update_tile_pos()
 {
-	_tile_pos = _world->world_to_grid( transform->location );
+	const Vec3 tile_pos = _world->world_to_grid( transform->location );
+	if ( _world_index == -1 )
+	{
+		_tile_pos = tile_pos;
+	}
+	else
+	{
+		_world->_hot_states.tile_positions[_world_index] = tile_pos;
+	}
+
+	_world->on_pawn_tile_pos_changed( this );
 }
 
 Vec3 Pawn::get_tile_pos() const
 {
-	return _tile_pos;
+	if ( _world_index == -1 ) return _tile_pos;
+
+	return _world->_hot_states.tile_positions[_world_index];
+}
+
+void Pawn::set_hunger( float hunger )
+{
+	if ( _world_index == -1 )
+	{
+		_hunger = hunger;
+		return;
+	}
+
+	_world->_hot_states.hungers[_world_index] = hunger;
+}
+
+float Pawn::get_hunger() const
+{
+	if ( _world_index == -1 ) return _hunger;
+
+	return _world->_hot_states.hungers[_world_index];
+}
+
+int Pawn::get_state_id() const
+{
+	if ( _world_index == -1 ) return _state_id;
+
+	return _world->_hot_states.state_ids[_world_index];
+}
+
+void Pawn::_set_state_id( int state_id )
+{
+	if ( _world_index == -1 )
+	{
+		_state_id = state_id;
+		return;
+	}
+
+	_world->_hot_states.state_ids[_world_index] = state_id;
 }
 
 bool Pawn::can_reproduce() const
 {
 	return data->max_child_spawn_count > 0
-		&& hunger >= data->min_hunger_for_reproduction;
+		&& get_hunger() >= data->min_hunger_for_reproduction;
 }
 
 bool Pawn::is_same_group( GroupID target_group_id ) const
 {
-	return group_id > 0 && group_id == target_group_id;
+	return _group_id > 0 && _group_id == target_group_id;
+}
+
+void Pawn::set_group_id( GroupID group_id )
+{
+	ASSERT( group_id >= 0 && group_id <= MAX_PAWN_GROUP_ID );
+	if ( group_id == _group_id ) return;
+
+	const GroupID previous_group_id = _group_id;
+	_group_id = group_id;
+	_world->on_pawn_group_id_changed( this, previous_group_id );
+}
+
+GroupID Pawn::get_group_id() const
+{
+	return _group_id;
+}
+
+void Pawn::set_wants_to_mate( bool wants_to_mate )
+{
+	if ( wants_to_mate == _wants_to_mate ) return;
+
+	_wants_to_mate = wants_to_mate;
+	_world->on_pawn_wants_to_mate_changed( this );
+}
+
+bool Pawn::wants_to_mate() const
+{
+	return _wants_to_mate;
 }
 
 const std::string& Pawn::get_name() const
@@ -218,6 +385,11 @@ const std::string& Pawn::get_name() const
 	return _name;
 }
 
+PawnHandle Pawn::get_handle() const
+{
+	return _handle;
+}
+
 World* Pawn::get_world() const
 {
 	return _world;
@@ -227,3 +399,62 @@ SafePtr<StateMachine<Pawn>> Pawn::get_state_machine() const
 {
 	return _state_machine;
 }
+
+void Pawn::kill()
+{
+	if ( _is_killed ) return;
+
+	_is_killed = true;
+	_world->on_pawn_killed( this );
+	Entity::kill();
+}
+
+bool Pawn::is_killed() const
+{
+	return _is_killed;
+}
+
+bool Pawn::is_suspended() const
+{
+	return _wake_tick != -1;
+}
+
+PawnAILod Pawn::get_ai_lod() const
+{
+	return _ai_lod;
+}
+
+Pawn::SimulatedTransform Pawn::_capture_transform() const
+{
+	return SimulatedTransform {
+		.location = transform->location,
+		.rotation = transform->rotation,
+		.scale = transform->scale,
+	};
+}
+
+void Pawn::_restore_simulated_transform()
+{
+	if ( !_is_transform_interpolated ) return;
+
+	transform->set_location( _simulated_transform.location );
+	transform->set_rotation( _simulated_transform.rotation );
+	transform->set_scale( _simulated_transform.scale );
+	_is_transform_interpolated = false;
+}
+
+void Pawn::_store_previous_transform()
+{
+	//	Only moving pawns are interpolated
+	if ( _state_machine == nullptr ) return;
+
+	_previous_transform = _capture_transform();
+}
+
+void Pawn::_store_simulated_transform()
+{
+	if ( _state_machine == nullptr ) return;
+
+	_simulated_transform = _capture_transform();
+	_is_transform_interpolated = true;
+}
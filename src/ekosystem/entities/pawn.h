@@ -21,43 +21,182 @@ namespace eks
 		Pawn( World* world, SafePtr<PawnData> data );
 
 		void setup() override;
+		/*
+		 * Updates the rendering of the pawn, its simulation is ticked by the world.
+		 */
 		void update_this( float dt ) override;
-		void tick( float dt );
-
-		void reproduce( SafePtr<Pawn> partner );
+		/*
+		 * Decision phase of a tick, updating the hunger from its consumption and photosynthesis.
+		 * Only reads the world and writes to this pawn, so pawns can run it in parallel.
+		 */
+		void tick_needs( float dt );
+		/*
+		 * Decision phase of a tick, choosing the state the next actions tick runs. Evaluating
+		 * the states only reads the world, searching for food and threats through the cached
+		 * queries, so pawns can run it in parallel.
+		 */
+		void tick_decisions();
+		/*
+		 * Commit phase of a tick, run after the decision phase of all pawns and one pawn at a
+		 * time: updates the state machine with its decided state, then reproduces or dies from hunger.
+		 */
+		void tick_actions( float dt );
+		/*
+		 * Cheap update of a dormant pawn, only applying its hunger, photosynthesis and
+		 * reproduction over the given elapsed time, without substepping.
+		 */
+		void coarse_tick( float dt );
+
+		void reproduce( Pawn* partner );
+
+		/*
+		 * Kills the pawn, removing it from the world before it is destroyed by the engine.
+		 */
+		void kill();
+		bool is_killed() const;
+
+		/*
+		 * Returns whenever the state machine is suspended by the world, see World::suspend_pawn.
+		 */
+		bool is_suspended() const;
+
+		/*
+		 * Returns the level of detail of the pawn's AI, updated by the world at each update.
+		 */
+		PawnAILod get_ai_lod() const;
 
 		void set_tile_pos( const Vec3& tile_pos );
 		void update_tile_pos();
 		Vec3 get_tile_pos() const;
 
+		void set_hunger( float hunger );
+		float get_hunger() const;
+
+		/*
+		 * Returns the index of the current state inside the state machine, -1 without any.
+		 * Refreshed after each actions tick.
+		 */
+		int get_state_id() const;
+
 		bool can_reproduce() const;
 		bool is_same_group( GroupID group_id ) const;
 
+		/*
+		 * Changes the group of the pawn, keeping the world's population counters up-to-date.
+		 */
+		void set_group_id( GroupID group_id );
+		GroupID get_group_id() const;
+
+		/*
+		 * Changes whenever the pawn is looking for a mate, registering it to
+		 * the world's mate matching.
+		 */
+		void set_wants_to_mate( bool wants_to_mate );
+		bool wants_to_mate() const;
+
 		const std::string& get_name() const;
 		World* get_world() const;
+		/*
+		 * Returns the handle referencing this pawn inside its world, null if not registered.
+		 */
+		PawnHandle get_handle() const;
 
 		SafePtr<StateMachine<Pawn>> get_state_machine() const;
 
 	public:
 		SafePtr<PawnData> data = nullptr;
 
-		GroupID group_id = 0;
-		float hunger = 1.0f;
-
-		bool wants_to_mate = false;
 		bool is_sleeping = false;
-		SafePtr<Pawn> partner_pawn = nullptr;
+		PawnHandle partner_pawn {};
+
+	private:
+		//  State of the transform at the end of a fixed step
+		struct SimulatedTransform
+		{
+			Vec3 location = Vec3::zero;
+			Quaternion rotation = Quaternion::identity;
+			Vec3 scale = Vec3::one;
+		};
+
+	private:
+		friend class World;
+
+		SimulatedTransform _capture_transform() const;
+		/*
+		 * Puts back the transform of the last fixed step in place of the interpolated one.
+		 */
+		void _restore_simulated_transform();
+		void _store_previous_transform();
+		void _store_simulated_transform();
+
+		void _set_state_id( int state_id );
 
 	private:
 		World* _world = nullptr;
+		GroupID _group_id = 0;
+		bool _wants_to_mate = false;
+		bool _is_killed = false;
 		SharedPtr<ModelRenderer> _renderer = nullptr;
 		SharedPtr<StateMachine<Pawn>> _state_machine = nullptr;
 		SharedPtr<ParticleRenderer> _sleep_particle_renderer = nullptr;
 		SharedPtr<ParticleRenderer> _love_particle_renderer = nullptr;
 
+		//  Transforms of the last two fixed steps, the rendered transform is interpolated
+		//  between them until the next step
+		SimulatedTransform _previous_transform {};
+		SimulatedTransform _simulated_transform {};
+		bool _is_transform_interpolated = false;
+
+		//  World tick at which the suspended state machine is woken up, -1 if not suspended
+		int _wake_tick = -1;
+		//  Time elapsed while suspended, handed to the state machine once woken up
+		float _suspended_time = 0.0f;
+
+		PawnAILod _ai_lod = PawnAILod::Near;
+		//  Time elapsed since the last needs and actions ticks, accumulated over the steps skipped
+		//  by the AI level of detail or, for the actions, postponed by the world's frame budget
+		float _needs_time = 0.0f;
+		float _actions_time = 0.0f;
+		//  Whenever the actions tick was due but postponed by the world's frame budget
+		bool _is_tick_deferred = false;
+
+		//  Hot state while not registered, stored by the world's hot states otherwise
 		//  Position in tile coordinates
 		Vec3 _tile_pos = Vec3::zero;
+		float _hunger = 1.0f;
+		int _state_id = -1;
+		//  Index inside the world's pawns list and hot states, -1 if not registered
+		int _world_index = -1;
+		PawnHandle _handle {};
+		//  Index of the world's spatial grid cell containing this pawn and index inside it
+		int _grid_cell_id = -1;
+		int _grid_cell_index = -1;
+		//  Index of the world's occupancy tile containing this pawn and index inside it
+		int _tile_id = -1;
+		int _tile_index = -1;
+		//  Index of the world's chunk containing this pawn and index inside it
+		int _chunk_id = -1;
+		int _chunk_index = -1;
+		//  Whenever this pawn is counted as mobile by its chunk
+		bool _is_chunk_mobile = false;
+		//  Indexes inside the world's membership lists, -1 if not registered
+		int _adjective_list_ids[ADJECTIVES_COUNT] { -1, -1, -1, -1, -1 };
+		int _data_list_id = -1;
+		//  Adjectives this pawn has been listed with, kept in case its data is edited
+		Adjectives _listed_adjectives = Adjectives::None;
+		//  Ids inside the world's food fields, -1 if not a source
+		int _food_field_source_ids[FOOD_FIELDS_COUNT] { -1, -1 };
+		//  Index inside the world's mate candidates of its data, -1 if not registered
+		int _mate_candidate_index = -1;
+
+		//  Cached results of the world's queries per type, refreshed by const queries
+		mutable PawnQueryCacheEntry _query_cache[PAWN_QUERY_TYPES_COUNT] {};
+		//  Queries requested to the world's next batch as a bitmask of their types, and their radius
+		mutable uint8 _requested_queries_mask = 0;
+		mutable float _requested_query_radii[PAWN_QUERY_TYPES_COUNT] {};
 
 		std::string _name = "";
 	};
-}
\ No newline at end of file
+}
+
+#include <ekosystem/world-queries.hpp>
\ No newline at end of file
@@ -23,7 +23,7 @@ namespace eks
 			Pawn* owner = machine->owner;
 			if ( owner->data->move_speed <= 0.0f ) return false;
 			if ( owner->data->has_adjective( Adjectives::Photosynthesis ) ) return false;
-			if ( owner->hunger >= owner->data->min_hunger_to_eat ) return false;
+			if ( owner->get_hunger() >= owner->data->min_hunger_to_eat ) return false;
 
 			//	Check for food first
 			if ( !_find_food_task->find_food().is_valid() ) return false;
@@ -37,7 +37,7 @@ namespace eks
 		}
 
 	private:
-		SafePtr<Pawn> _target = nullptr;
+		PawnHandle _target {};
 
 		PawnFindFoodStateTask* _find_food_task = nullptr;
 	};
@@ -8,18 +8,19 @@ namespace eks
 	{
 	public:
 		PawnFleeState( float radius )
-			: _radius_sqr( radius * radius )
+			: _radius( radius )
 		{
 			create_task<PawnFleeFromStateTask>( &_target_pawn, radius + 2.0f );
 		}
 
 		void on_begin() override
 		{
-			_target_pawn = _find_flee_target();
+			const SafePtr<Pawn> target = _find_flee_target();
+			_target_pawn = target.is_valid() ? target->get_handle() : PawnHandle {};
 		}
 		void on_end() override
 		{
-			_target_pawn = nullptr;
+			_target_pawn = PawnHandle {};
 		}
 
 		bool can_switch_to() const override
@@ -44,26 +45,15 @@ namespace eks
 			const Pawn* owner = machine->owner;
 			const World* world = owner->get_world();
 
-			return world->find_nearest_pawn(
-				owner->get_tile_pos(),
-				[&]( const SafePtr<Pawn> pawn ) {
-					if ( pawn.get() == owner ) return false;
-					if ( pawn->data == owner->data ) return false;
-
-					if ( owner->data->has_adjective( Adjectives::Meat ) && !pawn->data->has_adjective( Adjectives::Carnivore ) ) return false;
-
-					const float dist_sqr = Vec3::distance2d_sqr( pawn->get_tile_pos(), owner->get_tile_pos() );
-					if ( dist_sqr > _radius_sqr ) return false;
-
-					return true;
-				}
-			);
+			//	Have the next search resolved by the world's batch, read back from the cache
+			world->request_query( owner, PawnQueryType::Threat, _radius );
+			return world->find_threat_for( owner, _radius );
 		}
 
 	private:
-		SafePtr<Pawn> _target_pawn = nullptr;
+		PawnHandle _target_pawn {};
 		Vec3 _flee_location = Vec3::zero;
 
-		float _radius_sqr = 0.0f;
+		float _radius = 0.0f;
 	};
 }
\ No newline at end of file
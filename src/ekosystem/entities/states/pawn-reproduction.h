@@ -20,16 +20,17 @@ namespace eks
 		{
 			const Pawn* owner = machine->owner;
 			if ( owner->data->max_child_spawn_count <= 0 ) return false;
-			if ( owner->hunger < owner->data->min_hunger_for_reproduction ) return false;
+			if ( owner->get_hunger() < owner->data->min_hunger_for_reproduction ) return false;
 
 			//	Has a group assigned and is not exceeding its population limit?
-			if ( owner->group_id > 0 )
+			const GroupID group_id = owner->get_group_id();
+			if ( group_id > 0 )
 			{
 				const World* world = owner->get_world();
-				const int population_limit = world->get_group_limit( owner->group_id );
+				const int population_limit = world->get_group_limit( group_id );
 				if ( population_limit > 0 )
 				{
-					const int current_population = world->get_pawns_count_in_group( owner->group_id );
+					const int current_population = world->get_pawns_count_in_group( group_id );
 					if ( current_population >= population_limit ) return false;
 				}
 			}
@@ -41,8 +42,5 @@ namespace eks
 		{
 			return "PawnReproductionState";
 		}
-
-	private:
-		SafePtr<Pawn> _target;
 	};
 }
\ No newline at end of file
@@ -9,30 +9,30 @@ namespace eks
 	class PawnEatStateTask : public StateTask<Pawn>
 	{
 	public:
-		PawnEatStateTask( SafePtr<Pawn>* target_key ) 
+		PawnEatStateTask( PawnHandle* target_key ) 
 			: target_key( target_key )
 		{};
 
 		void on_begin() override
 		{
-			SafePtr<Pawn> target = *target_key;
-			if ( !target.is_valid() )
+			Pawn* owner = state->machine->owner;
+
+			World* world = owner->get_world();
+
+			Pawn* target = world->get_pawn( *target_key );
+			if ( target == nullptr || target->is_killed() )
 			{
 				finish( StateTaskResult::Failed );
 				return;
 			}
 
-			Pawn* owner = state->machine->owner;
-
-			owner->hunger = math::min(
-				owner->hunger + target->data->food_amount,
-				owner->data->max_hunger
-			);
-			target->kill();
-
-			printf(
-				"'%s' ate '%s'\n",
-				*owner->get_name(), *target->get_name()
+			//	Eaten at the end of the tick, unless another pawn ate it first
+			world->enqueue_command(
+				PawnCommand {
+					.type = PawnCommandType::Kill,
+					.target = target->get_handle(),
+					.instigator = owner->get_handle(),
+				}
 			);
 
 			finish( StateTaskResult::Succeed );
@@ -44,6 +44,6 @@ namespace eks
 		}
 
 	public:
-		SafePtr<Pawn>* target_key = nullptr;
+		PawnHandle* target_key = nullptr;
 	};
 }
\ No newline at end of file
@@ -9,7 +9,7 @@ namespace eks
 	class PawnFindFoodStateTask : public StateTask<Pawn>
 	{
 	public:
-		PawnFindFoodStateTask( SafePtr<Pawn>* target_key )
+		PawnFindFoodStateTask( PawnHandle* target_key )
 			: target_key( target_key )
 		{};
 
@@ -33,7 +33,7 @@ namespace eks
 			}
 
 			//	Assign target
-			*target_key = target;
+			*target_key = target->get_handle();
 			finish( StateTaskResult::Succeed );
 		}
 
@@ -47,45 +47,12 @@ namespace eks
 			const Pawn* owner = state->machine->owner;
 			const World* world = owner->get_world();
 
-			if ( owner->data->has_adjective( Adjectives::Herbivore ) )
-			{
-				//  Make herbivore pawns find vegetal pawns as a meal
-
-				auto target = world->find_nearest_pawn(
-					owner->get_tile_pos(),
-					[&]( auto pawn )
-					{
-						if ( pawn.get() == owner ) return false;
-						if ( pawn->is_same_group( owner->group_id ) ) return false;
-						return pawn->data->has_adjective( Adjectives::Vegetal );
-					}
-				);
-				if ( !target.is_valid() ) return nullptr;
-
-				return target;
-			}
-			else if ( owner->data->has_adjective( Adjectives::Carnivore ) )
-			{
-				//  Make carnivore pawns find meat pawns as a meal
-
-				auto target = world->find_nearest_pawn(
-					owner->get_tile_pos(),
-					[&]( auto pawn )
-					{
-						if ( pawn.get() == owner ) return false;
-						if ( pawn->is_same_group( owner->group_id ) ) return false;
-						return pawn->data->has_adjective( Adjectives::Meat );
-					}
-				);
-				if ( !target.is_valid() ) return nullptr;
-
-				return target;
-			}
-
-			return nullptr;
+			//	Have the next search resolved by the world's batch, read back from the cache
+			world->request_query( owner, PawnQueryType::Food );
+			return world->find_food_for( owner );
 		}
 
 	public:
-		SafePtr<Pawn>* target_key = nullptr;
+		PawnHandle* target_key = nullptr;
 	};
 }
\ No newline at end of file
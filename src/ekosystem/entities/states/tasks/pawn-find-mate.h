@@ -9,19 +9,22 @@ namespace eks
 	class PawnFindMateStateTask : public StateTask<Pawn>
 	{
 	public:
-		PawnFindMateStateTask( SafePtr<Pawn>* target_key )
+		PawnFindMateStateTask( PawnHandle* target_key )
 			: target_key( target_key )
 		{};
 
 		void on_begin() override
 		{
 			Pawn* owner = state->machine->owner;
-			owner->wants_to_mate = true;
+			owner->set_wants_to_mate( true );
 
 			if ( owner->data->move_speed <= 0.0f )
 			{
 				finish( StateTaskResult::Failed );
+				return;
 			}
+
+			owner->get_world()->request_query( owner, PawnQueryType::Mate );
 		}
 		void on_update( float dt ) override
 		{
@@ -32,7 +35,7 @@ namespace eks
 		void on_end() override
 		{
 			Pawn* owner = state->machine->owner;
-			owner->wants_to_mate = false;
+			owner->set_wants_to_mate( false );
 		}
 
 		bool can_ignore() const override
@@ -51,37 +54,20 @@ namespace eks
 		bool find_mate()
 		{
 			Pawn* owner = state->machine->owner;
-			const World* world = owner->get_world();
 
-			if ( owner->partner_pawn )
+			//	Partners are assigned by the world's batch of queries
+			World* world = owner->get_world();
+			if ( !world->is_pawn_valid( owner->partner_pawn ) )
 			{
-				*target_key = owner->partner_pawn;
-				return true;
+				world->request_query( owner, PawnQueryType::Mate );
+				return false;
 			}
 
-			auto mate_pawn = world->find_nearest_pawn(
-				owner->get_tile_pos(),
-				[&]( auto pawn )
-				{
-					if ( pawn.get() == owner ) return false;
-					return pawn->data == owner->data && pawn->wants_to_mate;
-				}
-			);
-			if ( !mate_pawn.is_valid() ) return false;
-
-			printf(
-				"'%s' will mate with '%s'\n",
-				*owner->get_name(), *mate_pawn->get_name()
-			);
-
-			owner->partner_pawn = mate_pawn;
-			mate_pawn->partner_pawn = owner->as<Pawn>();
-			*target_key = mate_pawn;
-
+			*target_key = owner->partner_pawn;
 			return true;
 		}
 
 	public:
-		SafePtr<Pawn>* target_key = nullptr;
+		PawnHandle* target_key = nullptr;
 	};
 }
\ No newline at end of file
@@ -24,13 +24,16 @@ namespace eks
 		}
 		void on_update( float dt ) override
 		{
-			const Vec3 spread = random::generate_location(
-				-radius, -radius, 0.0f,
-				 radius,  radius, 0.0f
-			);
-
 			const Pawn* owner = state->machine->owner;
-			const Box world_bounds = owner->get_world()->get_bounds();
+			const World* world = owner->get_world();
+
+			const Vec3 spread {
+				world->generate_random( -radius, radius ),
+				world->generate_random( -radius, radius ),
+				0.0f
+			};
+
+			const Box world_bounds = world->get_tile_bounds();
 			*location_key = Vec3::clamp(
 				Vec3::round( owner->get_tile_pos() + spread ),
 				world_bounds.min, world_bounds.max
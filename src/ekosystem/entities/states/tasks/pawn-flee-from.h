@@ -7,7 +7,7 @@ namespace eks
 	class PawnFleeFromStateTask : public PawnMoveStateTask
 	{
 	public:
-		PawnFleeFromStateTask( SafePtr<Pawn>* target_key, float radius )
+		PawnFleeFromStateTask( PawnHandle* target_key, float radius )
 			: _flee_target_key( target_key ), _radius_sqr( radius * radius ),
 			  PawnMoveStateTask( &_flee_location )
 		{}
@@ -18,14 +18,15 @@ namespace eks
 
 			_last_target_location = Vec3::zero;
 
-			if ( _flee_target_key->is_valid() )
+			if ( const Pawn* target = _get_flee_target() )
 			{
-				_update_flee_location();
+				_update_flee_location( target );
 			}
 		}
 		void on_update( float dt ) override
 		{
-			if ( !_flee_target_key->is_valid() )
+			const Pawn* target = _get_flee_target();
+			if ( target == nullptr )
 			{
 				if ( !is_moving() )
 				{
@@ -37,9 +38,9 @@ namespace eks
 				return;
 			}
 
-			if ( _last_target_location != ( *_flee_target_key )->get_tile_pos() )
+			if ( _last_target_location != target->get_tile_pos() )
 			{
-				_update_flee_location();
+				_update_flee_location( target );
 			}
 
 		#ifdef ENABLE_VISDEBUG
@@ -70,10 +71,10 @@ namespace eks
 			if ( !can_switch ) return false;
 
 			//	Check the pawn is out-of-range from the target
-			if ( _flee_target_key->is_valid() )
+			if ( const Pawn* target = _get_flee_target() )
 			{
 				const Pawn* owner = state->machine->owner;
-				const float dist_sqr = Vec3::distance2d_sqr( owner->get_tile_pos(), ( *_flee_target_key )->get_tile_pos() );
+				const float dist_sqr = Vec3::distance2d_sqr( owner->get_tile_pos(), target->get_tile_pos() );
 				return dist_sqr >= _radius_sqr;
 			}
 
@@ -86,17 +87,28 @@ namespace eks
 		}
 
 	private:
-		void _update_flee_location()
+		const Pawn* _get_flee_target() const
+		{
+			const Pawn* owner = state->machine->owner;
+			return owner->get_world()->get_pawn( *_flee_target_key );
+		}
+
+		void _update_flee_location( const Pawn* target )
 		{
 			const Pawn* owner = state->machine->owner;
 			const Vec3 owner_location = owner->get_tile_pos();
 			const World* world = owner->get_world();
-			const Box bounds = world->get_bounds();
+			const Box bounds = world->get_tile_bounds();
 
-			_last_target_location = ( *_flee_target_key )->get_tile_pos();
+			_last_target_location = target->get_tile_pos();
 
-			//	Compute flee direction
-			Vec3 flee_direction = Vec3::direction2d( _last_target_location, owner_location );
+			//	Compute flee direction, going down the threat field to get away from
+			//	all nearby threats, or straight away from the target otherwise
+			Vec3 flee_direction = world->get_threat_flee_direction( owner );
+			if ( flee_direction == Vec3::zero )
+			{
+				flee_direction = Vec3::direction2d( _last_target_location, owner_location );
+			}
 
 			//	Flee perpendicular from the original flee direction when near world edges
 			bool is_on_world_edge = owner_location.x == bounds.min.x || owner_location.x == bounds.max.x
@@ -128,7 +140,7 @@ namespace eks
 		}
 
 	private:
-		SafePtr<Pawn>* _flee_target_key = nullptr;
+		PawnHandle* _flee_target_key = nullptr;
 
 		Vec3 _flee_location = Vec3::zero;
 		Vec3 _last_target_location = Vec3::zero;
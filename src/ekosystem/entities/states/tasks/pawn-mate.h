@@ -9,14 +9,14 @@ namespace eks
 	class PawnMateStateTask : public StateTask<Pawn>
 	{
 	public:
-		PawnMateStateTask( SafePtr<Pawn>* partner_key ) 
+		PawnMateStateTask( PawnHandle* partner_key ) 
 			: partner_key( partner_key )
 		{};
 
 		void on_begin() override
 		{
-			SafePtr<Pawn> partner = *partner_key;
 			Pawn* owner = state->machine->owner;
+			Pawn* partner = owner->get_world()->get_pawn( *partner_key );
 
 			owner->reproduce( partner );
 			finish( StateTaskResult::Succeed );
@@ -28,6 +28,6 @@ namespace eks
 		}
 
 	public:
-		SafePtr<Pawn>* partner_key = nullptr;
+		PawnHandle* partner_key = nullptr;
 	};
 }
\ No newline at end of file
@@ -11,7 +11,7 @@ namespace eks
 	class PawnMoveStateTask : public StateTask<Pawn>
 	{
 	public:
-		PawnMoveStateTask( SafePtr<Pawn>* target_key, float acceptance_radius = 0.0f )
+		PawnMoveStateTask( PawnHandle* target_key, float acceptance_radius = 0.0f )
 			: pawn_target_key( target_key ), _acceptance_radius( acceptance_radius )
 		{};
 		PawnMoveStateTask( Vec3* target_key, float acceptance_radius = 0.0f )
@@ -161,7 +161,7 @@ namespace eks
 		}
 
 	public:
-		SafePtr<Pawn>* pawn_target_key = nullptr;
+		PawnHandle* pawn_target_key = nullptr;
 		Vec3* location_target_key = nullptr;
 
 	private:
@@ -174,9 +174,11 @@ namespace eks
 			Vec3 target_pos = Vec3::zero;
 			if ( pawn_target_key != nullptr )
 			{
-				if ( !pawn_target_key->is_valid() ) return false;
+				const Pawn* owner = state->machine->owner;
+				const Pawn* target = owner->get_world()->get_pawn( *pawn_target_key );
+				if ( target == nullptr ) return false;
 
-				target_pos = ( *pawn_target_key )->get_tile_pos();
+				target_pos = target->get_tile_pos();
 			}
 			else if ( location_target_key != nullptr )
 			{
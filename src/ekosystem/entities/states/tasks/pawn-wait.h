@@ -22,15 +22,25 @@ namespace eks
 			//	Apply random deviation to time
 			if ( random_deviation != 0.0f )
 			{
+				const World* world = state->machine->owner->get_world();
 				_max_time = math::max(
 					0.0f,
-					_max_time + random::generate( -random_deviation, random_deviation )
+					_max_time + world->generate_random( -random_deviation, random_deviation )
 				);
 			}
 		}
 		void on_update( float dt ) override
 		{
-			if ( ( _current_time += dt ) < _max_time ) return;
+			if ( ( _current_time += dt ) < _max_time )
+			{
+				//	Skip the updates until the end of the wait when the state can't be switched from
+				if ( !state->can_switch_from() )
+				{
+					Pawn* owner = state->machine->owner;
+					owner->get_world()->suspend_pawn( owner, _max_time - _current_time );
+				}
+				return;
+			}
 
 			finish( StateTaskResult::Succeed );
 		}
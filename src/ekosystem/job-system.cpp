@@ -0,0 +1,240 @@
+#include "job-system.h"
+
+#include <suprengine/utils/assert.h>
+
+#include <algorithm>
+
+using namespace eks;
+
+//  Job system owning the calling worker thread, and the index of its queue
+static thread_local const JobSystem* s_worker_job_system = nullptr;
+static thread_local int s_worker_queue_index = 0;
+
+JobSystem::JobSystem( int threads_count )
+{
+	set_threads_count( threads_count );
+}
+
+JobSystem::~JobSystem()
+{
+	_stop_workers();
+}
+
+void JobSystem::set_threads_count( int threads_count )
+{
+	if ( threads_count <= 0 )
+	{
+		threads_count = std::max( 1, static_cast<int>( std::thread::hardware_concurrency() ) );
+	}
+	if ( !_queues.empty() && threads_count == get_threads_count() ) return;
+
+	_stop_workers();
+	_start_workers( threads_count - 1 );
+}
+
+int JobSystem::get_threads_count() const
+{
+	return static_cast<int>( _workers.size() ) + 1;
+}
+
+void JobSystem::run( JobFunction function, JobCounter* counter, const JobCounter* dependency )
+{
+	if ( counter != nullptr )
+	{
+		counter->value.fetch_add( 1, std::memory_order_relaxed );
+	}
+
+	_push_or_park_job(
+		_get_queue_index(),
+		Job {
+			.function = std::move( function ),
+			.counter = counter,
+			.dependency = dependency,
+		}
+	);
+}
+
+void JobSystem::wait( const JobCounter& counter )
+{
+	const int queue_index = _get_queue_index();
+	while ( !counter.is_done() )
+	{
+		if ( !_try_run_job( queue_index ) )
+		{
+			std::this_thread::yield();
+		}
+	}
+}
+
+void JobSystem::parallel_for( int count, int batch_size, const RangeFunction& function )
+{
+	if ( count <= 0 ) return;
+
+	batch_size = std::max( 1, batch_size );
+	const int batches_count = ( count + batch_size - 1 ) / batch_size;
+	if ( _workers.empty() || batches_count == 1 )
+	{
+		function( 0, count );
+		return;
+	}
+
+	JobCounter counter {};
+	for ( int batch = 0; batch < batches_count; batch++ )
+	{
+		const int begin = batch * batch_size;
+		const int end = std::min( begin + batch_size, count );
+		run( [&function, begin, end] { function( begin, end ); }, &counter );
+	}
+	wait( counter );
+}
+
+void JobSystem::_start_workers( int workers_count )
+{
+	_should_stop = false;
+
+	_queues.clear();
+	for ( int i = 0; i < workers_count + 1; i++ )
+	{
+		_queues.push_back( std::make_unique<JobQueue>() );
+	}
+
+	_workers.reserve( workers_count );
+	for ( int i = 0; i < workers_count; i++ )
+	{
+		_workers.emplace_back( &JobSystem::_work, this, i + 1 );
+	}
+}
+
+void JobSystem::_stop_workers()
+{
+	ASSERT_MSG( _queued_jobs_count == 0, "Job system stopped with queued jobs" );
+	ASSERT_MSG( _parked_jobs.empty(), "Job system stopped with jobs waiting on a dependency" );
+
+	{
+		std::lock_guard<std::mutex> lock( _sleep_mutex );
+		_should_stop = true;
+	}
+	_sleep_condition.notify_all();
+
+	for ( std::thread& worker : _workers )
+	{
+		worker.join();
+	}
+	_workers.clear();
+}
+
+void JobSystem::_work( int queue_index )
+{
+	s_worker_job_system = this;
+	s_worker_queue_index = queue_index;
+
+	while ( !_should_stop )
+	{
+		if ( _try_run_job( queue_index ) ) continue;
+
+		std::unique_lock<std::mutex> lock( _sleep_mutex );
+		_sleep_condition.wait( lock, [&] { return _should_stop || _queued_jobs_count.load() > 0; } );
+	}
+}
+
+bool JobSystem::_try_run_job( int queue_index )
+{
+	Job job {};
+	if ( !_pop_job( queue_index, &job ) && !_steal_job( queue_index, &job ) ) return false;
+
+	job.function();
+
+	//  The last job of a counter releases the jobs depending on it
+	if ( job.counter != nullptr && job.counter->value.fetch_sub( 1, std::memory_order_acq_rel ) == 1 )
+	{
+		_release_parked_jobs( queue_index, job.counter );
+	}
+	return true;
+}
+
+bool JobSystem::_pop_job( int queue_index, Job* out_job )
+{
+	JobQueue& queue = *_queues[queue_index];
+
+	std::lock_guard<std::mutex> lock( queue.mutex );
+	if ( queue.jobs.empty() ) return false;
+
+	*out_job = std::move( queue.jobs.back() );
+	queue.jobs.pop_back();
+	_queued_jobs_count--;
+	return true;
+}
+
+bool JobSystem::_steal_job( int queue_index, Job* out_job )
+{
+	const int queues_count = static_cast<int>( _queues.size() );
+	for ( int offset = 1; offset < queues_count; offset++ )
+	{
+		JobQueue& queue = *_queues[( queue_index + offset ) % queues_count];
+
+		std::lock_guard<std::mutex> lock( queue.mutex );
+		if ( queue.jobs.empty() ) continue;
+
+		*out_job = std::move( queue.jobs.front() );
+		queue.jobs.pop_front();
+		_queued_jobs_count--;
+		return true;
+	}
+
+	return false;
+}
+
+void JobSystem::_push_or_park_job( int queue_index, Job&& job )
+{
+	if ( job.dependency != nullptr && !job.dependency->is_done() )
+	{
+		//  Check again once locked, since the dependency may have been released in the meantime
+		std::lock_guard<std::mutex> lock( _parked_mutex );
+		if ( !job.dependency->is_done() )
+		{
+			_parked_jobs[job.dependency].push_back( std::move( job ) );
+			return;
+		}
+	}
+
+	_push_job( queue_index, std::move( job ) );
+}
+
+void JobSystem::_release_parked_jobs( int queue_index, const JobCounter* dependency )
+{
+	std::vector<Job> released_jobs {};
+	{
+		std::lock_guard<std::mutex> lock( _parked_mutex );
+		const auto itr = _parked_jobs.find( dependency );
+		if ( itr == _parked_jobs.end() ) return;
+
+		released_jobs = std::move( itr->second );
+		_parked_jobs.erase( itr );
+	}
+
+	for ( Job& job : released_jobs )
+	{
+		_push_job( queue_index, std::move( job ) );
+	}
+}
+
+void JobSystem::_push_job( int queue_index, Job&& job )
+{
+	JobQueue& queue = *_queues[queue_index];
+	{
+		std::lock_guard<std::mutex> lock( queue.mutex );
+		queue.jobs.push_back( std::move( job ) );
+		_queued_jobs_count++;
+	}
+
+	//  Lock before notifying so a worker can't miss it between its check and its wait
+	{
+		std::lock_guard<std::mutex> lock( _sleep_mutex );
+	}
+	_sleep_condition.notify_one();
+}
+
+int JobSystem::_get_queue_index() const
+{
+	return s_worker_job_system == this ? s_worker_queue_index : 0;
+}
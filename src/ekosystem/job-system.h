@@ -0,0 +1,127 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace eks
+{
+	/*
+	 * Number of unfinished jobs, used to wait for them or to make other jobs depend on them.
+	 */
+	struct JobCounter
+	{
+	public:
+		bool is_done() const { return value.load( std::memory_order_acquire ) == 0; }
+
+	public:
+		std::atomic<int> value { 0 };
+	};
+
+	/*
+	 * Work-stealing scheduler running jobs over a pool of worker threads.
+	 *
+	 * Each thread owns a deque of jobs: it pushes and pops its own jobs at the back, while
+	 * idle threads steal the oldest jobs at the front of the others. The threads outside
+	 * of the pool (i.e. the game thread) share the first deque, and help running the jobs
+	 * while waiting on a counter, so a system of N threads only spawns N - 1 workers.
+	 */
+	class JobSystem
+	{
+	public:
+		using JobFunction = std::function<void()>;
+		using RangeFunction = std::function<void( int begin, int end )>;
+
+	public:
+		JobSystem( int threads_count = 0 );
+		~JobSystem();
+
+		JobSystem( const JobSystem& ) = delete;
+		JobSystem& operator=( const JobSystem& ) = delete;
+
+		/*
+		 * Changes the number of threads, including the calling one.
+		 * Set to 0 to use all hardware threads. Must not be called while jobs are running.
+		 */
+		void set_threads_count( int threads_count );
+		int get_threads_count() const;
+
+		/*
+		 * Queues a job on the deque of the calling thread. The optional counter is incremented
+		 * until the job is done. With an optional dependency, the job is parked until the last
+		 * job of the dependency is done, then queued on the deque of the thread which ran it.
+		 */
+		void run( JobFunction function, JobCounter* counter = nullptr, const JobCounter* dependency = nullptr );
+		/*
+		 * Runs queued jobs on the calling thread until the counter is done.
+		 */
+		void wait( const JobCounter& counter );
+
+		/*
+		 * Calls the function over consecutive ranges of at most 'batch_size' indices covering
+		 * [0; count), as parallel jobs, and returns once all of them are done.
+		 * Runs on the calling thread alone when there is only a single range.
+		 */
+		void parallel_for( int count, int batch_size, const RangeFunction& function );
+
+	private:
+		struct Job
+		{
+			JobFunction function = nullptr;
+			JobCounter* counter = nullptr;
+			const JobCounter* dependency = nullptr;
+		};
+		struct JobQueue
+		{
+			std::mutex mutex {};
+			std::deque<Job> jobs {};
+		};
+
+	private:
+		void _start_workers( int workers_count );
+		void _stop_workers();
+		void _work( int queue_index );
+
+		/*
+		 * Runs a single job, popped from the given queue or stolen from another one.
+		 * Returns whenever a job has been run.
+		 */
+		bool _try_run_job( int queue_index );
+		bool _pop_job( int queue_index, Job* out_job );
+		bool _steal_job( int queue_index, Job* out_job );
+		void _push_job( int queue_index, Job&& job );
+		/*
+		 * Queues the job, or parks it until its dependency is done.
+		 */
+		void _push_or_park_job( int queue_index, Job&& job );
+		/*
+		 * Queues the jobs parked on the dependency, which just got done.
+		 */
+		void _release_parked_jobs( int queue_index, const JobCounter* dependency );
+
+		/*
+		 * Returns the index of the queue owned by the calling thread.
+		 */
+		int _get_queue_index() const;
+
+	private:
+		//  Queue 0 belongs to the threads outside of the pool, the others to their worker
+		std::vector<std::unique_ptr<JobQueue>> _queues {};
+		std::vector<std::thread> _workers {};
+
+		std::mutex _sleep_mutex {};
+		std::condition_variable _sleep_condition {};
+		std::atomic<int> _queued_jobs_count { 0 };
+		std::atomic<bool> _should_stop { false };
+
+		//  Jobs waiting on their dependency, kept out of the queues until it is done
+		std::mutex _parked_mutex {};
+		std::unordered_map<const JobCounter*, std::vector<Job>> _parked_jobs {};
+	};
+}
@@ -0,0 +1,356 @@
+#include "pawn-distance-field.h"
+
+#include <suprengine/utils/assert.h>
+
+#include "entities/pawn.h"
+
+#include <algorithm>
+
+using namespace eks;
+
+template <typename FunctionType>
+void PawnDistanceField::_for_each_neighbour( int tile_id, FunctionType&& function ) const
+{
+	const int x = tile_id % _width;
+	const int y = tile_id / _width;
+
+	for ( int offset_y = -1; offset_y <= 1; offset_y++ )
+	{
+		const int neighbour_y = y + offset_y;
+		if ( neighbour_y < 0 || neighbour_y >= _height ) continue;
+
+		for ( int offset_x = -1; offset_x <= 1; offset_x++ )
+		{
+			const int neighbour_x = x + offset_x;
+			if ( neighbour_x < 0 || neighbour_x >= _width ) continue;
+			if ( offset_x == 0 && offset_y == 0 ) continue;
+
+			function( neighbour_y * _width + neighbour_x );
+		}
+	}
+}
+
+template <typename FunctionType>
+void PawnDistanceField::_for_each_tile_in_box( int tile_id, int radius, FunctionType&& function ) const
+{
+	const int x = tile_id % _width;
+	const int y = tile_id / _width;
+
+	const int min_x = math::max( x - radius, 0 );
+	const int max_x = math::min( x + radius, _width - 1 );
+	const int min_y = math::max( y - radius, 0 );
+	const int max_y = math::min( y + radius, _height - 1 );
+	for ( int box_y = min_y; box_y <= max_y; box_y++ )
+	{
+		for ( int box_x = min_x; box_x <= max_x; box_x++ )
+		{
+			function( box_y * _width + box_x );
+		}
+	}
+}
+
+void PawnDistanceField::resize( int width, int height, float max_distance, int block_size )
+{
+	ASSERT( block_size > 0 );
+
+	_width = width;
+	_height = height;
+	_max_distance = max_distance;
+	_max_distance_sqr = max_distance * max_distance;
+	_max_distance_tiles = static_cast<int>( math::ceil( max_distance ) );
+
+	_block_size = block_size;
+	_blocks_width = ( _width + _block_size - 1 ) / _block_size;
+	const int blocks_height = ( _height + _block_size - 1 ) / _block_size;
+	_blocks.clear();
+	_blocks.resize( static_cast<size_t>( _blocks_width * blocks_height ) );
+	_allocated_block_ids.clear();
+
+	_sources.clear();
+	_free_source_ids.clear();
+	_sources_count = 0;
+	_queue.clear();
+}
+
+void PawnDistanceField::clear()
+{
+	//  NOTE: Released blocks are swapped with the last allocated one, so they are
+	//  iterated backward to only move already visited blocks.
+	for ( int i = static_cast<int>( _allocated_block_ids.size() ) - 1; i >= 0; i-- )
+	{
+		const int block_id = _allocated_block_ids[i];
+		Block& block = _blocks[block_id];
+		if ( block.filled_tiles_count == 0 )
+		{
+			_release_block( block_id );
+			continue;
+		}
+
+		std::fill( block.tiles.begin(), block.tiles.end(), Tile {} );
+		block.filled_tiles_count = 0;
+	}
+
+	_sources.clear();
+	_free_source_ids.clear();
+	_sources_count = 0;
+	_queue.clear();
+}
+
+int PawnDistanceField::add_source( const SafePtr<Pawn>& pawn, int tile_id )
+{
+	ASSERT( tile_id >= 0 && tile_id < _width * _height );
+
+	//  Re-use the ids of removed sources
+	int source_id = -1;
+	if ( !_free_source_ids.empty() )
+	{
+		source_id = _free_source_ids.back();
+		_free_source_ids.pop_back();
+	}
+	else
+	{
+		source_id = static_cast<int>( _sources.size() );
+		_sources.emplace_back();
+	}
+	_sources_count++;
+
+	Source& source = _sources[source_id];
+	source.pawn = pawn;
+	source.tile_id = tile_id;
+	source.next_stacked_id = -1;
+
+	//  Stack the source behind the one already seeding this tile
+	const Tile& tile = _get_tile( tile_id );
+	if ( tile.source_id != -1 && tile.distance_sqr == 0.0f )
+	{
+		Source& seed_source = _sources[tile.source_id];
+		source.next_stacked_id = seed_source.next_stacked_id;
+		seed_source.next_stacked_id = source_id;
+		return source_id;
+	}
+
+	_set_tile( tile_id, Tile { 0.0f, source_id } );
+	_queue.push_back( tile_id );
+	return source_id;
+}
+
+void PawnDistanceField::remove_source( int source_id )
+{
+	ASSERT( source_id >= 0 && source_id < static_cast<int>( _sources.size() ) );
+
+	Source& source = _sources[source_id];
+	const int seed_tile_id = source.tile_id;
+	const Tile seed_tile = _get_tile( seed_tile_id );
+
+	//  NOTE: The tiles of a source are not always connected, since another source may be nearer
+	//  in between, but they all are within the maximum distance of its seed tile.
+	if ( seed_tile.source_id != source_id )
+	{
+		//  Unlink the source from the stack of its tile, the field is unchanged
+		int previous_id = seed_tile.source_id;
+		while ( _sources[previous_id].next_stacked_id != source_id )
+		{
+			previous_id = _sources[previous_id].next_stacked_id;
+		}
+		_sources[previous_id].next_stacked_id = source.next_stacked_id;
+	}
+	else if ( source.next_stacked_id != -1 )
+	{
+		//  Hand over the tiles to the next source stacked on the same tile, the distances are unchanged
+		const int next_source_id = source.next_stacked_id;
+		_for_each_tile_in_box( seed_tile_id, _max_distance_tiles,
+			[&]( int tile_id )
+			{
+				const Tile& tile = _get_tile( tile_id );
+				if ( tile.source_id != source_id ) return;
+
+				_set_tile( tile_id, Tile { tile.distance_sqr, next_source_id } );
+			}
+		);
+	}
+	else
+	{
+		//  Clear the tiles of the source and queue the other sources around, up to the tiles
+		//  bordering its reach, to fill them back
+		_for_each_tile_in_box( seed_tile_id, _max_distance_tiles + 1,
+			[&]( int tile_id )
+			{
+				const int tile_source_id = _get_tile( tile_id ).source_id;
+				if ( tile_source_id == -1 ) return;
+
+				if ( tile_source_id != source_id )
+				{
+					_queue.push_back( tile_id );
+					return;
+				}
+
+				_set_tile( tile_id, Tile {} );
+			}
+		);
+	}
+
+	source.pawn = nullptr;
+	source.tile_id = -1;
+	source.next_stacked_id = -1;
+	_free_source_ids.push_back( source_id );
+	_sources_count--;
+}
+
+void PawnDistanceField::propagate()
+{
+	for ( size_t i = 0; i < _queue.size(); i++ )
+	{
+		const int tile_id = _queue[i];
+
+		//  Tiles may have been cleared since being queued
+		const int source_id = _get_tile( tile_id ).source_id;
+		if ( source_id == -1 ) continue;
+
+		const int source_tile_id = _sources[source_id].tile_id;
+		if ( source_tile_id == -1 ) continue;
+
+		const int source_x = source_tile_id % _width;
+		const int source_y = source_tile_id / _width;
+
+		_for_each_neighbour( tile_id,
+			[&]( int neighbour_id )
+			{
+				const int diff_x = neighbour_id % _width - source_x;
+				const int diff_y = neighbour_id / _width - source_y;
+				const float distance_sqr = static_cast<float>( diff_x * diff_x + diff_y * diff_y );
+				if ( distance_sqr > _max_distance_sqr ) return;
+
+				//  Only keep the nearest source
+				if ( distance_sqr >= _get_tile( neighbour_id ).distance_sqr ) return;
+
+				_set_tile( neighbour_id, Tile { distance_sqr, source_id } );
+				_queue.push_back( neighbour_id );
+			}
+		);
+	}
+
+	_queue.clear();
+}
+
+SafePtr<Pawn> PawnDistanceField::get_source_at( int tile_id, float max_distance, float* out_distance_sqr ) const
+{
+	if ( tile_id < 0 || tile_id >= _width * _height ) return nullptr;
+
+	const Tile& tile = _get_tile( tile_id );
+	if ( tile.source_id == -1 || tile.distance_sqr > max_distance * max_distance ) return nullptr;
+
+	if ( out_distance_sqr != nullptr )
+	{
+		*out_distance_sqr = tile.distance_sqr;
+	}
+	return _sources[tile.source_id].pawn;
+}
+
+Vec3 PawnDistanceField::get_gradient_at( int tile_id ) const
+{
+	if ( tile_id < 0 || tile_id >= _width * _height ) return Vec3::zero;
+
+	const int x = tile_id % _width;
+	const int y = tile_id / _width;
+
+	//  Tiles out of reach of any source are considered at the maximum distance
+	auto get_distance_sqr = [&]( int tile_x, int tile_y )
+	{
+		//  Clamp to the field edges, giving one-sided differences there
+		tile_x = math::clamp( tile_x, 0, _width - 1 );
+		tile_y = math::clamp( tile_y, 0, _height - 1 );
+		return math::min( _get_tile( tile_y * _width + tile_x ).distance_sqr, _max_distance_sqr );
+	};
+
+	//  Central differences, pointing toward increasing distances
+	Vec3 direction {
+		get_distance_sqr( x + 1, y ) - get_distance_sqr( x - 1, y ),
+		get_distance_sqr( x, y + 1 ) - get_distance_sqr( x, y - 1 ),
+		0.0f
+	};
+	if ( direction == Vec3::zero ) return Vec3::zero;
+
+	direction.normalize2d();
+	return direction;
+}
+
+int PawnDistanceField::get_sources_count() const
+{
+	return _sources_count;
+}
+
+int PawnDistanceField::get_allocated_blocks_count() const
+{
+	return static_cast<int>( _allocated_block_ids.size() );
+}
+
+float PawnDistanceField::get_max_distance() const
+{
+	return _max_distance;
+}
+
+int PawnDistanceField::_get_block_id( int tile_id, int* out_local_id ) const
+{
+	const int x = tile_id % _width;
+	const int y = tile_id / _width;
+	*out_local_id = ( y % _block_size ) * _block_size + x % _block_size;
+	return ( y / _block_size ) * _blocks_width + x / _block_size;
+}
+
+const PawnDistanceField::Tile& PawnDistanceField::_get_tile( int tile_id ) const
+{
+	static const Tile EMPTY_TILE {};
+
+	int local_id = 0;
+	const Block& block = _blocks[_get_block_id( tile_id, &local_id )];
+	if ( block.tiles.empty() ) return EMPTY_TILE;
+
+	return block.tiles[local_id];
+}
+
+void PawnDistanceField::_set_tile( int tile_id, const Tile& tile )
+{
+	int local_id = 0;
+	const int block_id = _get_block_id( tile_id, &local_id );
+	Block& block = _blocks[block_id];
+	if ( block.tiles.empty() )
+	{
+		//  Empty tiles don't need their block
+		if ( tile.source_id == -1 ) return;
+
+		block.tiles.resize( static_cast<size_t>( _block_size * _block_size ) );
+		block.allocated_index = static_cast<int>( _allocated_block_ids.size() );
+		_allocated_block_ids.push_back( block_id );
+	}
+
+	Tile& block_tile = block.tiles[local_id];
+	if ( block_tile.source_id == -1 && tile.source_id != -1 )
+	{
+		block.filled_tiles_count++;
+	}
+	else if ( block_tile.source_id != -1 && tile.source_id == -1 )
+	{
+		block.filled_tiles_count--;
+	}
+	block_tile = tile;
+
+	if ( block.filled_tiles_count == 0 )
+	{
+		_release_block( block_id );
+	}
+}
+
+void PawnDistanceField::_release_block( int block_id )
+{
+	Block& block = _blocks[block_id];
+
+	//  Swap and pop from the allocated blocks
+	const int last_block_id = _allocated_block_ids.back();
+	_allocated_block_ids[block.allocated_index] = last_block_id;
+	_blocks[last_block_id].allocated_index = block.allocated_index;
+	_allocated_block_ids.pop_back();
+
+	std::vector<Tile>().swap( block.tiles );
+	block.filled_tiles_count = 0;
+	block.allocated_index = -1;
+}
@@ -0,0 +1,139 @@
+#pragma once
+
+#include <suprengine/math/vec3.h>
+
+#include <suprengine/utils/memory.h>
+
+#include <vector>
+
+namespace eks
+{
+	using namespace suprengine;
+
+	class Pawn;
+
+	/*
+	 * Field storing, for each tile of a grid, the nearest source pawn and its squared distance.
+	 *
+	 * Sources are propagated breadth-first to the neighbour tiles up to a maximum distance.
+	 * Adding or removing a source only updates the tiles within its reach, so the field can
+	 * be maintained incrementally. Being propagated tile by tile, the nearest
+	 * source is an approximation of the exact euclidean one.
+	 *
+	 * Tiles are stored by square blocks, only allocated while a source reaches them, so
+	 * large and mostly empty grids stay cheap. Tiles of other blocks read as out of reach.
+	 */
+	class PawnDistanceField
+	{
+	public:
+		/*
+		 * Resizes the field to the given dimensions in tiles, split into blocks of the given
+		 * size, removing all sources.
+		 */
+		void resize( int width, int height, float max_distance, int block_size );
+		/*
+		 * Removes all sources, only resetting the allocated blocks. The blocks which were not
+		 * reached since the previous clear are released, the others are kept for re-use.
+		 */
+		void clear();
+
+		/*
+		 * Adds a source on the given tile and returns its id.
+		 * The tiles are only updated by the next propagation.
+		 */
+		int add_source( const SafePtr<Pawn>& pawn, int tile_id );
+		/*
+		 * Removes the source of the given id, clearing the tiles it was the nearest source of.
+		 * These tiles are only re-filled by the neighbour sources at the next propagation.
+		 */
+		void remove_source( int source_id );
+		/*
+		 * Propagates the sources added or uncovered since the last propagation.
+		 */
+		void propagate();
+
+		/*
+		 * Returns the nearest source of the tile within the given distance, or nullptr.
+		 * The squared distance to the source is written in the optional output.
+		 */
+		SafePtr<Pawn> get_source_at( int tile_id, float max_distance, float* out_distance_sqr = nullptr ) const;
+		/*
+		 * Returns the 2D direction of increasing distances at the given tile, going away
+		 * from the nearest sources. Returns a zero vector if the field is flat there.
+		 */
+		Vec3 get_gradient_at( int tile_id ) const;
+
+		int get_sources_count() const;
+		int get_allocated_blocks_count() const;
+		float get_max_distance() const;
+
+	private:
+		struct Tile
+		{
+			//  Squared distance in tiles to the nearest source
+			float distance_sqr = math::PLUS_INFINITY;
+			//  Id of the nearest source, -1 if none
+			int source_id = -1;
+		};
+		struct Source
+		{
+			SafePtr<Pawn> pawn = nullptr;
+			int tile_id = -1;
+			//  Next source stacked on the same tile, only the first one is propagated
+			int next_stacked_id = -1;
+		};
+		struct Block
+		{
+			//  Tiles of the block, empty until a source reaches it
+			std::vector<Tile> tiles {};
+			//  Number of tiles having a source, the block is released once none is left
+			int filled_tiles_count = 0;
+			//  Index inside the allocated blocks, -1 if not allocated
+			int allocated_index = -1;
+		};
+
+	private:
+		/*
+		 * Calls the function with the id of each existing neighbour tile.
+		 */
+		template <typename FunctionType>
+		void _for_each_neighbour( int tile_id, FunctionType&& function ) const;
+		/*
+		 * Calls the function with the id of each existing tile within the given
+		 * Chebyshev distance from the tile, itself included.
+		 */
+		template <typename FunctionType>
+		void _for_each_tile_in_box( int tile_id, int radius, FunctionType&& function ) const;
+
+		int _get_block_id( int tile_id, int* out_local_id ) const;
+		/*
+		 * Returns the tile, or an empty one if its block is not allocated.
+		 */
+		const Tile& _get_tile( int tile_id ) const;
+		/*
+		 * Writes the tile, allocating its block if needed and releasing it once it has no source left.
+		 */
+		void _set_tile( int tile_id, const Tile& tile );
+		void _release_block( int block_id );
+
+	private:
+		int _width = 0;
+		int _height = 0;
+		float _max_distance = 0.0f;
+		float _max_distance_sqr = 0.0f;
+		//  Maximum distance rounded up to whole tiles, bounding the tiles a source can reach
+		int _max_distance_tiles = 0;
+
+		std::vector<Block> _blocks {};
+		int _block_size = 1;
+		int _blocks_width = 0;
+		std::vector<int> _allocated_block_ids {};
+
+		std::vector<Source> _sources {};
+		std::vector<int> _free_source_ids {};
+		int _sources_count = 0;
+
+		//  Tiles whose source must be propagated to their neighbours
+		std::vector<int> _queue {};
+	};
+}
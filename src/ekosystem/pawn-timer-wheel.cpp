@@ -0,0 +1,98 @@
+#include "pawn-timer-wheel.h"
+
+#include <suprengine/utils/assert.h>
+
+using namespace eks;
+
+void PawnTimerWheel::reset( int tick )
+{
+	for ( auto& level_slots : _slots )
+	{
+		for ( std::vector<PawnTimer>& slot : level_slots )
+		{
+			slot.clear();
+		}
+	}
+
+	_tick = tick;
+	_timers_count = 0;
+}
+
+void PawnTimerWheel::schedule( const PawnTimer& timer )
+{
+	ASSERT_MSG( timer.wake_tick > _tick, "Timers must be scheduled after the current tick" );
+	ASSERT_MSG( timer.wake_tick - _tick <= MAX_DELAY_TICKS, "Timers can't be scheduled that far" );
+
+	_insert( timer );
+	_timers_count++;
+}
+
+void PawnTimerWheel::advance( int tick, std::vector<PawnTimer>* out_expired_timers )
+{
+	while ( _tick < tick )
+	{
+		_tick++;
+
+		//  Find the highest level reaching a new slot, all the lower ones did as well
+		int top_level = 0;
+		while ( top_level + 1 < LEVELS_COUNT
+			 && ( _tick & ( ( 1 << ( LEVEL_BITS * ( top_level + 1 ) ) ) - 1 ) ) == 0 )
+		{
+			top_level++;
+		}
+
+		//  Move their timers down, from the highest level so they can end up in lower slots being cascaded
+		for ( int level = top_level; level > 0; level-- )
+		{
+			_cascade( level );
+		}
+
+		std::vector<PawnTimer>& slot = _slots[0][_tick & ( SLOTS_COUNT - 1 )];
+		if ( slot.empty() ) continue;
+
+		out_expired_timers->insert( out_expired_timers->end(), slot.begin(), slot.end() );
+		_timers_count -= static_cast<int>( slot.size() );
+		slot.clear();
+	}
+}
+
+int PawnTimerWheel::get_tick() const
+{
+	return _tick;
+}
+
+int PawnTimerWheel::get_timers_count() const
+{
+	return _timers_count;
+}
+
+void PawnTimerWheel::_insert( const PawnTimer& timer )
+{
+	//  Use the lowest level whose span contains both the current and the wake tick
+	int level = 0;
+	while ( level + 1 < LEVELS_COUNT
+		 && ( timer.wake_tick >> ( LEVEL_BITS * ( level + 1 ) ) ) != ( _tick >> ( LEVEL_BITS * ( level + 1 ) ) ) )
+	{
+		level++;
+	}
+
+	//  NOTE: Past the span of the top level, the slot index wraps around and the timer is
+	//  cascaded once the wheel reaches it again, which MAX_DELAY_TICKS keeps in time.
+	const int slot_id = ( timer.wake_tick >> ( LEVEL_BITS * level ) ) & ( SLOTS_COUNT - 1 );
+	_slots[level][slot_id].push_back( timer );
+}
+
+void PawnTimerWheel::_cascade( int level )
+{
+	std::vector<PawnTimer>& slot = _slots[level][( _tick >> ( LEVEL_BITS * level ) ) & ( SLOTS_COUNT - 1 )];
+	if ( slot.empty() ) return;
+
+	//  Swap out the slot first, since its timers may be re-inserted in it
+	_cascaded_timers.clear();
+	_cascaded_timers.swap( slot );
+
+	for ( const PawnTimer& timer : _cascaded_timers )
+	{
+		_insert( timer );
+	}
+}
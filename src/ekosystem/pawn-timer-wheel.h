@@ -0,0 +1,73 @@
+#pragma once
+
+#include <ekosystem/entities/pawn-handle.h>
+
+#include <vector>
+
+namespace eks
+{
+	/*
+	 * Timer waking a pawn at a given world tick.
+	 */
+	struct PawnTimer
+	{
+		PawnHandle handle {};
+		int wake_tick = 0;
+	};
+
+	/*
+	 * Hierarchical timer wheel scheduling pawn timers by world tick.
+	 *
+	 * Each level is a ring of slots covering 64 times the span of the level below: level 0
+	 * holds the timers due within the current 64 ticks, one slot per tick. Scheduling and
+	 * expiring a timer are done in constant time, and a timer is only moved down a level
+	 * when the wheel reaches its slot, so advancing a tick only touches the due timers.
+	 *
+	 * Timers can't be cancelled: their owner ignores them once stale, see World::suspend_pawn.
+	 */
+	class PawnTimerWheel
+	{
+	public:
+		static constexpr int LEVEL_BITS = 6;
+		static constexpr int SLOTS_COUNT = 1 << LEVEL_BITS;
+		static constexpr int LEVELS_COUNT = 4;
+
+		//  Maximum delay in ticks between the current tick and a timer's wake tick
+		static constexpr int MAX_DELAY_TICKS = ( 1 << ( LEVEL_BITS * LEVELS_COUNT ) ) - 1;
+
+	public:
+		/*
+		 * Removes all timers and restarts the wheel at the given tick.
+		 */
+		void reset( int tick );
+
+		/*
+		 * Schedules a timer at its wake tick, which must be after the current tick
+		 * and within MAX_DELAY_TICKS of it.
+		 */
+		void schedule( const PawnTimer& timer );
+		/*
+		 * Advances the wheel tick by tick up to the given one, appending the expired timers
+		 * to the output in their wake order.
+		 */
+		void advance( int tick, std::vector<PawnTimer>* out_expired_timers );
+
+		int get_tick() const;
+		int get_timers_count() const;
+
+	private:
+		void _insert( const PawnTimer& timer );
+		/*
+		 * Re-inserts the timers of the current slot of the given level into the lower levels.
+		 */
+		void _cascade( int level );
+
+	private:
+		int _tick = 0;
+		int _timers_count = 0;
+
+		std::vector<PawnTimer> _slots[LEVELS_COUNT][SLOTS_COUNT] {};
+		//  Scratch storage of the cascaded timers
+		std::vector<PawnTimer> _cascaded_timers {};
+	};
+}
@@ -54,7 +54,7 @@ void GameScene::init()
 
 void GameScene::setup_world()
 {
-	_world = new World( Vec2 { 20.0f, 20.0f } );
+	_world = new World( Vec2 { 20.0f, 20.0f }, &_job_system );
 
 	auto hare_data  = _world->get_pawn_data( "hare" );
 	auto grass_data = _world->get_pawn_data( "grass" );
@@ -70,14 +70,14 @@ void GameScene::setup_world()
 	for ( int i = 0; i < 6; i++ )
 	{
 		auto hare = _world->create_pawn( hare_data, _world->find_random_tile_pos() );
-		hare->group_id = 2;
+		hare->set_group_id( 2 );
 	}
 
 	//	Spawn wolves
 	for ( int i = 0; i < 2; i++ )
 	{
 		auto wolf = _world->create_pawn( wolf_data, _world->find_random_tile_pos() );
-		wolf->group_id = 1; //	Prevent wolves from eating each other
+		wolf->set_group_id( 1 ); //	Prevent wolves from eating each other
 	}
 
 	//	Set default group limits
@@ -87,6 +87,8 @@ void GameScene::setup_world()
 
 void GameScene::update( float dt )
 {
+	//  Pawns close to the camera are ticked at full rate, the far away ones at a coarser one
+	_world->set_ai_lod_focus( _world->world_to_grid( _camera_controller->transform->location ) );
 	_world->update( dt );
 
 	Engine* engine = _game->get_engine();
@@ -25,6 +25,8 @@ namespace eks
 		void update( float dt ) override;
 
 	private:
+		//  Declared before the world, which uses it until deleted
+		JobSystem _job_system {};
 		World* _world { nullptr };
 		SafePtr<CameraController> _camera_controller;
 		DebugMenu _debug_menu;
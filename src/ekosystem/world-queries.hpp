@@ -0,0 +1,288 @@
+#pragma once
+
+//  Definitions of the templated World queries, kept apart from 'world.h'
+//  since they need the complete Pawn type.
+
+#include <ekosystem/entities/pawn.h>
+
+namespace eks
+{
+	template <typename FilterType>
+	SafePtr<Pawn> World::find_nearest_pawn( const Vec3& origin, FilterType&& filter ) const
+	{
+		return _find_nearest_pawn_in_grid( origin, filter, math::PLUS_INFINITY );
+	}
+
+	template <typename FilterType>
+	SafePtr<Pawn> World::find_nearest_pawn_with(
+		Adjectives adjectives,
+		const Vec3& origin,
+		FilterType&& filter
+	) const
+	{
+		if ( adjectives == Adjectives::None ) return _find_nearest_pawn_in_grid( origin, filter, math::PLUS_INFINITY );
+
+		//  Find the smallest membership list among the required adjectives
+		const std::vector<SafePtr<Pawn>>* candidates = nullptr;
+		for ( int bit = 0; bit < ADJECTIVES_COUNT; bit++ )
+		{
+			const Adjectives adjective = static_cast<Adjectives>( 1u << bit );
+			if ( ( adjectives & adjective ) != adjective ) continue;
+
+			const std::vector<SafePtr<Pawn>>& pawns = _pawns_by_adjective[bit];
+			if ( candidates == nullptr || pawns.size() < candidates->size() )
+			{
+				candidates = &pawns;
+			}
+		}
+		if ( candidates == nullptr || candidates->empty() ) return nullptr;
+
+		const auto adjectives_filter = [&]( const SafePtr<Pawn>& pawn )
+		{
+			if ( !pawn->data->has_adjective( adjectives ) ) return false;
+			return filter( pawn );
+		};
+
+		//  NOTE: A linear scan costs the number of candidates while the grid search costs roughly
+		//  the number of pawns surrounding the nearest candidate (i.e. total / candidates).
+		if ( candidates->size() * candidates->size() <= _pawns.size() )
+		{
+			return _find_nearest_pawn_in_list( *candidates, origin, adjectives_filter, math::PLUS_INFINITY );
+		}
+
+		return _find_nearest_pawn_in_grid( origin, adjectives_filter, math::PLUS_INFINITY );
+	}
+
+	template <typename FilterType>
+	SafePtr<Pawn> World::find_nearest_pawn_of(
+		const PawnData* data,
+		const Vec3& origin,
+		FilterType&& filter
+	) const
+	{
+		const std::vector<SafePtr<Pawn>>& candidates = get_pawns_of( data );
+		if ( candidates.empty() ) return nullptr;
+
+		if ( candidates.size() * candidates.size() <= _pawns.size() )
+		{
+			return _find_nearest_pawn_in_list( candidates, origin, filter, math::PLUS_INFINITY );
+		}
+
+		return _find_nearest_pawn_in_grid(
+			origin,
+			[&]( const SafePtr<Pawn>& pawn )
+			{
+				if ( pawn->data.get() != data ) return false;
+				return filter( pawn );
+			},
+			math::PLUS_INFINITY
+		);
+	}
+
+	template <typename FilterType>
+	SafePtr<Pawn> World::find_nearest_pawn_in_radius(
+		const Vec3& origin,
+		float radius,
+		FilterType&& filter,
+		Adjectives adjectives
+	) const
+	{
+		if ( adjectives == Adjectives::None ) return _find_nearest_pawn_in_grid( origin, filter, radius );
+
+		const auto adjectives_filter = [&]( const SafePtr<Pawn>& pawn )
+		{
+			if ( !pawn->data->has_adjective( adjectives ) ) return false;
+			return filter( pawn );
+		};
+
+		//  Find the smallest membership list among the required adjectives
+		const std::vector<SafePtr<Pawn>>* candidates = nullptr;
+		for ( int bit = 0; bit < ADJECTIVES_COUNT; bit++ )
+		{
+			const Adjectives adjective = static_cast<Adjectives>( 1u << bit );
+			if ( ( adjectives & adjective ) != adjective ) continue;
+
+			const std::vector<SafePtr<Pawn>>& pawns = _pawns_by_adjective[bit];
+			if ( candidates == nullptr || pawns.size() < candidates->size() )
+			{
+				candidates = &pawns;
+			}
+		}
+		if ( candidates == nullptr || candidates->empty() ) return nullptr;
+
+		//  Prefer scanning the candidates when there are fewer of them than the pawns
+		//  expected inside the cells covered by the radius
+		const float radius_cells = 2.0f * radius / PAWN_GRID_CELL_SIZE + 1.0f;
+		const float covered_cells = radius_cells * radius_cells;
+		const size_t grid_cells_count = static_cast<size_t>( _pawn_grid_width * _pawn_grid_height );
+		if ( candidates->size() * grid_cells_count <= _pawns.size() * covered_cells )
+		{
+			return _find_nearest_pawn_in_list( *candidates, origin, adjectives_filter, radius );
+		}
+
+		return _find_nearest_pawn_in_grid( origin, adjectives_filter, radius );
+	}
+
+	template <typename FilterType, typename FunctionType>
+	void World::for_each_pawn_in_radius(
+		const Vec3& origin,
+		float radius,
+		FilterType&& filter,
+		FunctionType&& function
+	) const
+	{
+		const float radius_sqr = radius * radius;
+
+		//  Visit the cells overlapping the square containing the radius
+		int min_x = 0, min_y = 0, max_x = 0, max_y = 0;
+		_get_grid_cell_coords( origin - Vec3 { radius, radius, 0.0f }, &min_x, &min_y );
+		_get_grid_cell_coords( origin + Vec3 { radius, radius, 0.0f }, &max_x, &max_y );
+
+		for ( int y = min_y; y <= max_y; y++ )
+		{
+			for ( int x = min_x; x <= max_x; x++ )
+			{
+				for ( const SafePtr<Pawn>& pawn : _get_grid_cell( x, y ) )
+				{
+					if ( Vec3::distance2d_sqr( origin, pawn->get_tile_pos() ) > radius_sqr ) continue;
+					if ( !filter( pawn ) ) continue;
+
+					function( pawn );
+				}
+			}
+		}
+	}
+
+	template <typename FilterType>
+	SafePtr<Pawn> World::find_pawn( FilterType&& filter ) const
+	{
+		for ( const SafePtr<Pawn>& pawn : _pawns )
+		{
+			if ( filter( pawn ) )
+			{
+				return pawn;
+			}
+		}
+
+		return nullptr;
+	}
+
+	template <typename FunctionType>
+	void World::_for_each_grid_cell_in_ring( int origin_x, int origin_y, int ring, FunctionType&& function ) const
+	{
+		const int min_y = math::max( origin_y - ring, 0 );
+		const int max_y = math::min( origin_y + ring, _pawn_grid_height - 1 );
+		const int min_x = math::max( origin_x - ring, 0 );
+		const int max_x = math::min( origin_x + ring, _pawn_grid_width - 1 );
+
+		for ( int y = min_y; y <= max_y; y++ )
+		{
+			//  Top and bottom rows are entirely in the ring, other rows only have their edges
+			const bool is_edge_row = y == origin_y - ring || y == origin_y + ring;
+			if ( is_edge_row || ring == 0 )
+			{
+				for ( int x = min_x; x <= max_x; x++ )
+				{
+					int local_id = 0;
+					const WorldChunk& chunk = _chunks[_get_grid_cell_chunk_id( x, y, &local_id )];
+
+					//  Skip the rest of the row inside a chunk without pawns at once
+					if ( chunk.grid_cells.empty() )
+					{
+						x = ( x / CHUNK_GRID_SIZE + 1 ) * CHUNK_GRID_SIZE - 1;
+						continue;
+					}
+
+					function( chunk.grid_cells[local_id] );
+				}
+				continue;
+			}
+
+			for ( int x = origin_x - ring; x <= origin_x + ring; x += ring * 2 )
+			{
+				if ( x < min_x || x > max_x ) continue;
+
+				function( _get_grid_cell( x, y ) );
+			}
+		}
+	}
+
+	template <typename FilterType>
+	SafePtr<Pawn> World::_find_nearest_pawn_in_grid( const Vec3& origin, FilterType&& filter, float max_dist ) const
+	{
+		SafePtr<Pawn> nearest_pawn = nullptr;
+		float nearest_dist = math::PLUS_INFINITY;
+		const float max_dist_sqr = max_dist * max_dist;
+
+		int origin_x = 0, origin_y = 0;
+		_get_grid_cell_coords( origin, &origin_x, &origin_y );
+
+		//  Search outward, ring by ring of cells around the origin cell
+		int max_ring = math::max( _pawn_grid_width, _pawn_grid_height ) - 1;
+		if ( max_dist < math::PLUS_INFINITY )
+		{
+			//  Rings further than this one can't contain a pawn within the maximum distance
+			max_ring = math::min( max_ring, static_cast<int>( max_dist / PAWN_GRID_CELL_SIZE ) + 1 );
+		}
+
+		for ( int ring = 0; ring <= max_ring; ring++ )
+		{
+			//  Pawns inside this ring are at least ( ring - 1 ) cells away on one axis, so
+			//  stop as soon as none of them could be closer than the current nearest pawn
+			if ( nearest_pawn.is_valid() && ring > 0 )
+			{
+				const float ring_min_dist = static_cast<float>( ( ring - 1 ) * PAWN_GRID_CELL_SIZE );
+				if ( nearest_dist <= ring_min_dist * ring_min_dist ) break;
+			}
+
+			_for_each_grid_cell_in_ring( origin_x, origin_y, ring,
+				[&]( const std::vector<SafePtr<Pawn>>& cell )
+				{
+					for ( const SafePtr<Pawn>& pawn : cell )
+					{
+						float dist = Vec3::distance2d_sqr(
+							origin,
+							pawn->get_tile_pos()
+						);
+						if ( dist > max_dist_sqr ) continue;
+						if ( nearest_pawn.is_valid() && nearest_dist <= dist ) continue;
+						if ( !filter( pawn ) ) continue;
+
+						nearest_pawn = pawn;
+						nearest_dist = dist;
+					}
+				}
+			);
+		}
+
+		return nearest_pawn;
+	}
+
+	template <typename FilterType>
+	SafePtr<Pawn> World::_find_nearest_pawn_in_list(
+		const std::vector<SafePtr<Pawn>>& pawns,
+		const Vec3& origin,
+		FilterType&& filter,
+		float max_dist
+	) const
+	{
+		SafePtr<Pawn> nearest_pawn = nullptr;
+		float nearest_dist = math::PLUS_INFINITY;
+		const float max_dist_sqr = max_dist * max_dist;
+		for ( const SafePtr<Pawn>& pawn : pawns )
+		{
+			float dist = Vec3::distance2d_sqr(
+				origin,
+				pawn->get_tile_pos()
+			);
+			if ( dist > max_dist_sqr ) continue;
+			if ( nearest_pawn.is_valid() && nearest_dist <= dist ) continue;
+			if ( !filter( pawn ) ) continue;
+
+			nearest_pawn = pawn;
+			nearest_dist = dist;
+		}
+
+		return nearest_pawn;
+	}
+}
\ No newline at end of file
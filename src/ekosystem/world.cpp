@@ -3,22 +3,31 @@
 #include <suprengine/core/assets.h>
 #include <suprengine/core/engine.h>
 
+#ifndef EKOSYSTEM_HEADLESS
 #include <suprengine/components/colliders/box-collider.h>
 #include <suprengine/components/renderers/model-renderer.hpp>
+#endif
 
 #include <suprengine/utils/assert.h>
 #include <suprengine/utils/random.h>
 #include <suprengine/utils/json.h>
 
 #include "entities/pawn.h"
+#ifndef EKOSYSTEM_HEADLESS
 #include "components/particle-renderer.h"
+#endif
 
+#include <algorithm>
+#include <chrono>
+#include <cmath>
 #include <filesystem>
 
 using namespace eks;
 
-World::World( const Vec2& size )
+World::World( const Vec2& size, JobSystem* job_system )
+	: _job_system( job_system )
 {
+#ifndef EKOSYSTEM_HEADLESS
 	auto& engine = Engine::instance();
 	auto model = Assets::get_model( "ekosystem::floor" );
 
@@ -39,12 +48,11 @@ World::World( const Vec2& size )
 	_moon = engine.create_entity<Entity>();
 	_moon->transform->scale = Vec3( 50.0f );
 	_moon->create_component<ModelRenderer>( Assets::get_model( "ekosystem::moon" ), "suprengine::texture", Color::white, -5 );
+#endif
 	
 	resize( size );
 
 	_init_datas();
-
-	engine.on_entity_removed.listen( &World::_on_entity_removed, this );
 }
 
 World::~World()
@@ -59,6 +67,102 @@ World::~World()
 
 void World::update( float dt )
 {
+	_fixed_time_accumulator += dt;
+
+	//  Cap the steps by the total pawn ticks allowed for a single update
+	int max_steps_count = max_fixed_steps_per_update;
+	if ( max_pawn_ticks_per_update > 0 && !_pawns.empty() )
+	{
+		const int pawns_count = static_cast<int>( _pawns.size() );
+		max_steps_count = math::min( max_steps_count, math::max( 1, max_pawn_ticks_per_update / pawns_count ) );
+	}
+
+	//  Run as many fixed steps as the accumulated time covers
+	const int steps_count = math::min( static_cast<int>( _fixed_time_accumulator / fixed_timestep ), max_steps_count );
+	_fixed_steps_count = 0;
+	bool is_budget_limited = false;
+	if ( steps_count > 0 )
+	{
+		_update_ai_lods();
+
+		using Clock = std::chrono::steady_clock;
+		const bool is_budgeted = _is_ai_budgeted();
+		_ai_budget_start_time = Clock::now();
+		_ai_budget_ticks_count = 0;
+		_is_ai_budget_exceeded = false;
+
+		//  Simulate from the transforms of the last step rather than the interpolated ones
+		for ( const SafePtr<Pawn>& pawn : _pawns )
+		{
+			pawn->_restore_simulated_transform();
+		}
+
+		for ( int step = 0; step < steps_count; step++ )
+		{
+			const Clock::time_point step_start_time = Clock::now();
+			const int step_start_ticks_count = _ai_budget_ticks_count;
+
+			//  With a frame budget, stop at the step after which another one would not fit,
+			//  estimating the next step to cost as much as the previous one
+			bool is_last_step = step == steps_count - 1;
+			if ( is_budgeted && !is_last_step )
+			{
+				const float spent_us = std::chrono::duration<float, std::micro>( step_start_time - _ai_budget_start_time ).count();
+				is_budget_limited = ( ai_frame_budget_us > 0 && spent_us + _step_cost_us * 2.0f >= ai_frame_budget_us )
+					|| ( ai_frame_budget_ticks > 0 && _ai_budget_ticks_count + _step_ticks_count * 2 >= ai_frame_budget_ticks );
+				is_last_step = is_budget_limited;
+			}
+
+			_fixed_update( fixed_timestep, is_last_step );
+			_fixed_steps_count++;
+
+			_step_cost_us = std::chrono::duration<float, std::micro>( Clock::now() - step_start_time ).count();
+			_step_ticks_count = _ai_budget_ticks_count - step_start_ticks_count;
+			if ( is_last_step ) break;
+		}
+
+		for ( const SafePtr<Pawn>& pawn : _pawns )
+		{
+			pawn->_store_simulated_transform();
+		}
+
+		if ( is_budgeted )
+		{
+			_ai_budget_spent_us = std::chrono::duration<float, std::micro>( Clock::now() - _ai_budget_start_time ).count();
+		}
+
+		_fixed_time_accumulator = math::max( _fixed_time_accumulator - _fixed_steps_count * fixed_timestep, 0.0f );
+	}
+
+	//  Keep the time the budget could not cover for the next updates, up to a hard cap so the backlog
+	//  can't spiral, but drop the time the capped steps could not cover instead of spiraling behind
+	const float max_accumulated_time = is_budget_limited ? math::max( max_ai_backlog_time, fixed_timestep ) : fixed_timestep;
+	_fixed_time_accumulator = math::min( _fixed_time_accumulator, max_accumulated_time );
+	_ai_backlog_time = is_budget_limited ? _fixed_time_accumulator : 0.0f;
+
+#ifndef EKOSYSTEM_HEADLESS
+	_update_day_night();
+#endif
+}
+
+void World::_fixed_update( float dt, bool is_last_step )
+{
+	_tick++;
+
+	_update_chunks( dt );
+
+	if ( is_morton_ordering_enabled && _tick % math::max( 1, morton_ordering_interval_ticks ) == 0 )
+	{
+		_reorder_pawns_by_morton();
+	}
+
+	//  Update the fields before the pawns query them
+	rebuild_threat_field();
+	for ( PawnDistanceField& food_field : _food_fields )
+	{
+		food_field.propagate();
+	}
+
 	// Update world time
 	constexpr float FULL_CYCLE_GAME_TIME = 24.0f;
 	_world_time = math::fmod( _world_time + dt * world_time_scale, FULL_CYCLE_GAME_TIME );
@@ -74,6 +178,205 @@ void World::update( float dt )
 		_photosynthesis_multiplier = photosynthesis_curve->evaluate_by_time( _world_time );
 	}
 
+	_wake_suspended_pawns();
+	resolve_queries();
+	_tick_pawns( dt, is_last_step );
+	apply_commands();
+}
+
+void World::_tick_pawns( float dt, bool is_last_step )
+{
+	//  NOTE: Births are queued and killed pawns are removed after the commit phase,
+	//  so the list is left untouched while iterating it.
+	const int pawns_count = static_cast<int>( _pawns.size() );
+
+	//  Decision phase: each pawn only reads the world and writes to itself
+	_parallel_for( pawns_count, PAWN_TICK_BATCH_SIZE,
+		[&]( int begin, int end )
+		{
+			for ( int i = begin; i < end; i++ )
+			{
+				Pawn* pawn = _pawns[i].get();
+
+				//  Pawns of dormant chunks are advanced by coarse updates
+				if ( pawn->is_killed() || is_pawn_dormant( pawn ) ) continue;
+
+				//  Accumulate the time of the steps skipped by the AI level of detail
+				pawn->_needs_time += dt;
+				const bool is_ai_lod_tick = _is_ai_lod_tick( pawn );
+				if ( is_ai_lod_tick )
+				{
+					pawn->tick_needs( pawn->_needs_time );
+					pawn->_needs_time = 0.0f;
+				}
+
+				//  Decide the next state of the pawns the commit phase is going to tick, after their
+				//  needs since the states depend on the hunger
+				if ( is_ai_lod_tick || pawn->_is_tick_deferred )
+				{
+					pawn->tick_decisions();
+				}
+			}
+		}
+	);
+
+	//  Commit phase: the decided states are run, applying moves, meals, births and deaths in the list order. With a frame
+	//  budget, the order starts after the last ticked pawn so the postponed ones are ticked first.
+	using Clock = std::chrono::steady_clock;
+	const bool is_budgeted = _is_ai_budgeted();
+	const int first_index = is_budgeted && pawns_count > 0 ? _ai_budget_cursor % pawns_count : 0;
+	if ( is_last_step )
+	{
+		_ai_backlog_count = 0;
+		_ai_lag = 0.0f;
+	}
+	_is_ticking_pawns = true;
+	for ( int offset = 0; offset < pawns_count; offset++ )
+	{
+		const int index = ( first_index + offset ) % pawns_count;
+		Pawn* pawn = _pawns[index].get();
+		if ( pawn->is_killed() || is_pawn_dormant( pawn ) ) continue;
+
+		//  Keep the transform preceding the last step to interpolate from it, even if not
+		//  ticked so the pawns skipped by the AI level of detail don't replay an old move
+		if ( is_last_step )
+		{
+			pawn->_store_previous_transform();
+		}
+
+		pawn->_actions_time += dt;
+		if ( !pawn->_is_tick_deferred && !_is_ai_lod_tick( pawn ) ) continue;
+
+		if ( _is_ai_budget_exceeded )
+		{
+			pawn->_is_tick_deferred = true;
+			if ( is_last_step )
+			{
+				_ai_backlog_count++;
+				_ai_lag = math::max( _ai_lag, pawn->_actions_time );
+			}
+			continue;
+		}
+
+		pawn->tick_actions( pawn->_actions_time );
+		pawn->_actions_time = 0.0f;
+		pawn->_is_tick_deferred = false;
+		_pawn_ticks_count++;
+
+		if ( is_budgeted )
+		{
+			_ai_budget_cursor = index + 1;
+			_ai_budget_ticks_count++;
+
+			if ( ai_frame_budget_us > 0 )
+			{
+				const float spent_us = std::chrono::duration<float, std::micro>( Clock::now() - _ai_budget_start_time ).count();
+				_is_ai_budget_exceeded = spent_us >= ai_frame_budget_us;
+			}
+			if ( ai_frame_budget_ticks > 0 )
+			{
+				_is_ai_budget_exceeded = _is_ai_budget_exceeded || _ai_budget_ticks_count >= ai_frame_budget_ticks;
+			}
+		}
+	}
+
+	_is_ticking_pawns = false;
+
+	for ( Pawn* pawn : _killed_pawns )
+	{
+		_remove_pawn( pawn );
+	}
+	_killed_pawns.clear();
+}
+
+void World::_update_ai_lods()
+{
+	const float near_distance_sqr = ai_lod_distances[0] * ai_lod_distances[0];
+	const float medium_distance_sqr = ai_lod_distances[1] * ai_lod_distances[1];
+
+	for ( const SafePtr<Pawn>& pawn : _pawns )
+	{
+		//  Pawns without a state machine are cheap to tick, their chunk dormancy handles them
+		if ( !is_ai_lod_enabled || pawn->_state_machine == nullptr )
+		{
+			pawn->_ai_lod = PawnAILod::Near;
+			continue;
+		}
+
+		if ( !_has_ai_lod_focus )
+		{
+			pawn->_ai_lod = PawnAILod::Far;
+			continue;
+		}
+
+		const float distance_sqr = Vec3::distance2d_sqr( _ai_lod_focus, pawn->get_tile_pos() );
+		if ( distance_sqr <= near_distance_sqr )
+		{
+			pawn->_ai_lod = PawnAILod::Near;
+		}
+		else if ( distance_sqr <= medium_distance_sqr )
+		{
+			pawn->_ai_lod = PawnAILod::Medium;
+		}
+		else
+		{
+			pawn->_ai_lod = PawnAILod::Far;
+		}
+	}
+}
+
+bool World::_is_ai_lod_tick( const Pawn* pawn ) const
+{
+	const int interval = ai_lod_tick_intervals[static_cast<int>( pawn->_ai_lod )];
+	if ( interval <= 1 ) return true;
+
+	return ( _tick + static_cast<int>( pawn->_handle.get_index() ) ) % interval == 0;
+}
+
+bool World::_is_ai_budgeted() const
+{
+	return ai_frame_budget_us > 0 || ai_frame_budget_ticks > 0;
+}
+
+void World::_wake_suspended_pawns()
+{
+	_expired_timers.clear();
+	_timer_wheel.advance( _tick, &_expired_timers );
+	for ( const PawnTimer& timer : _expired_timers )
+	{
+		//  Ignore the timers of removed pawns, or of pawns woken up or suspended again since
+		Pawn* pawn = get_pawn( timer.handle );
+		if ( pawn == nullptr || pawn->_wake_tick != timer.wake_tick ) continue;
+
+		wake_pawn( pawn );
+	}
+
+	if ( _suspended_pawns_count == 0 ) return;
+
+	//  Carnivores are few, so search the suspended prey around them rather than the opposite
+	for ( const SafePtr<Pawn>& carnivore : get_pawns_with( Adjectives::Carnivore ) )
+	{
+		for_each_pawn_in_radius(
+			carnivore->get_tile_pos(),
+			threat_wake_radius,
+			[]( const SafePtr<Pawn>& pawn )
+			{
+				return pawn->is_suspended() && _is_threat_field_prey( pawn.get() );
+			},
+			[&]( const SafePtr<Pawn>& pawn )
+			{
+				wake_pawn( pawn.get(), /* is_interrupted */ true );
+			}
+		);
+	}
+}
+
+#ifndef EKOSYSTEM_HEADLESS
+void World::_update_day_night()
+{
+	constexpr float FULL_CYCLE_GAME_TIME = 24.0f;
+	const float sun_angle = math::HALF_PI + _world_time / FULL_CYCLE_GAME_TIME * math::DOUBLE_PI;
+
 	Engine& engine = Engine::instance();
 
 	_sun->transform->set_location( -_sun_direction * 500.0f );
@@ -143,6 +446,7 @@ void World::update( float dt )
 
 	_skysphere_renderer->modulate.a = math::lerp( current_daynight.stars_opacity, next_daynight.stars_opacity, alpha ) * 255.0f;
 }
+#endif
 
 SharedPtr<Pawn> World::create_pawn(
 	SafePtr<PawnData> data,
@@ -154,7 +458,15 @@ SharedPtr<Pawn> World::create_pawn(
 	auto pawn = engine.create_entity<Pawn>( this, data );
 	pawn->set_tile_pos( tile_pos );
 
+	pawn->_world_index = static_cast<int>( _pawns.size() );
+	pawn->_handle = _allocate_pawn_slot( pawn.get() );
 	_pawns.push_back( pawn );
+	_attach_pawn_hot_state( pawn.get() );
+	_add_pawn_to_grid( pawn );
+	_add_pawn_to_tile( pawn );
+	_add_pawn_to_lists( pawn );
+	_add_pawn_to_food_fields( pawn );
+	_group_counts[pawn->get_group_id()]++;
 	return pawn;
 }
 
@@ -195,23 +507,180 @@ int World::get_group_limit( GroupID group_id ) const
 
 int World::get_pawns_count_in_group( GroupID group_id ) const
 {
-	int count = 0;
+	ASSERT( group_id >= 0 && group_id <= MAX_PAWN_GROUP_ID );
+	return _group_counts[group_id];
+}
 
-	for ( const SafePtr<Pawn>& pawn : _pawns )
+void World::enqueue_birth( const PawnBirth& birth )
+{
+	ASSERT( birth.group_id >= 0 && birth.group_id <= MAX_PAWN_GROUP_ID );
+	if ( birth.children_count <= 0 ) return;
+
+	_births.push_back( birth );
+	_pending_births_counts[birth.group_id] += birth.children_count;
+}
+
+void World::enqueue_command( const PawnCommand& command )
+{
+	_commands.push_back( command );
+}
+
+void World::apply_commands()
+{
+	//  NOTE: Commands are applied in the order pawns were ticked, so conflicts are always
+	//  resolved the same way. Births are queued by the pawns and never enqueue commands.
+	for ( const PawnCommand& command : _commands )
+	{
+		Pawn* target = get_pawn( command.target );
+		if ( target == nullptr || target->is_killed() ) continue;
+
+		Pawn* instigator = get_pawn( command.instigator );
+		switch ( command.type )
+		{
+			case PawnCommandType::Kill:
+			{
+				//  Eaters killed earlier in the tick don't get the food
+				if ( instigator != nullptr && !instigator->is_killed() )
+				{
+					instigator->set_hunger(
+						math::min(
+							instigator->get_hunger() + target->data->food_amount,
+							instigator->data->max_hunger
+						)
+					);
+
+					Logger::info(
+						"'%s' ate '%s'",
+						*instigator->get_name(), *target->get_name()
+					);
+				}
+
+				target->kill();
+				break;
+			}
+			case PawnCommandType::HungerDelta:
+			{
+				target->set_hunger( math::min( target->get_hunger() + command.amount, target->data->max_hunger ) );
+				break;
+			}
+			case PawnCommandType::PartnerLink:
+			{
+				target->partner_pawn = instigator != nullptr ? command.instigator : PawnHandle {};
+				break;
+			}
+		}
+	}
+	_commands.clear();
+
+	spawn_pending_births();
+}
+
+int World::get_pending_commands_count() const
+{
+	return static_cast<int>( _commands.size() );
+}
+
+void World::spawn_pending_births()
+{
+	if ( _births.empty() ) return;
+
+	//  Swap the queue out, births requested while spawning are kept for the next update
+	_spawning_births.swap( _births );
+
+	//  Place all children first, against the occupancy before any of them is spawned
+	_birth_placements.clear();
+	_birth_tile_ids.clear();
+	for ( int i = 0; i < static_cast<int>( _spawning_births.size() ); i++ )
 	{
-		if ( pawn->group_id == group_id )
+		const PawnBirth& birth = _spawning_births[i];
+		_pending_births_counts[birth.group_id] -= birth.children_count;
+		if ( !birth.data.is_valid() ) continue;
+
+		Vec3 spawn_pos = Vec3::zero;
+		int children_count = 0;
+		for ( ; children_count < birth.children_count; children_count++ )
+		{
+			if ( !find_empty_tile_pos_around( birth.parent_tile_pos, &spawn_pos, birth.adjectives_filter, &_birth_tile_ids ) ) break;
+
+			_birth_placements.emplace_back( i, spawn_pos );
+		}
+
+		if ( children_count < birth.children_count )
 		{
-			count++;
+			Logger::info(
+				"Only %d out of %d '%s' children were born, no empty tile is left around their parent.",
+				children_count, birth.children_count, *birth.data->name
+			);
 		}
 	}
 
+	//  Spawn all children at once
+	_pawns.reserve( _pawns.size() + _birth_placements.size() );
+	for ( const auto& [birth_index, spawn_pos] : _birth_placements )
+	{
+		const PawnBirth& birth = _spawning_births[birth_index];
+
+		auto child = create_pawn( birth.data, spawn_pos );
+		child->set_group_id( birth.group_id );
+	}
+
+	_spawning_births.clear();
+}
+
+int World::get_pending_births_count_in_group( GroupID group_id ) const
+{
+	ASSERT( group_id >= 0 && group_id <= MAX_PAWN_GROUP_ID );
+	return _pending_births_counts[group_id];
+}
+
+bool World::is_pawn_dormant( const Pawn* pawn ) const
+{
+	if ( !is_chunk_dormancy_enabled || pawn->_chunk_id == -1 ) return false;
+
+	return _chunks[pawn->_chunk_id].mobile_pawns_count == 0;
+}
+
+int World::get_chunks_count() const
+{
+	return static_cast<int>( _chunks.size() );
+}
+
+int World::get_dormant_chunks_count() const
+{
+	if ( !is_chunk_dormancy_enabled ) return 0;
+
+	int count = 0;
+	for ( const WorldChunk& chunk : _chunks )
+	{
+		if ( chunk.pawns.empty() || chunk.mobile_pawns_count > 0 ) continue;
+
+		count++;
+	}
+
 	return count;
 }
 
+Pawn* World::get_pawn( PawnHandle handle ) const
+{
+	const uint32_t index = handle.get_index();
+	if ( index >= _pawn_slots.size() ) return nullptr;
+
+	const PawnSlot& slot = _pawn_slots[index];
+	if ( slot.generation != handle.get_generation() ) return nullptr;
+
+	return slot.pawn;
+}
+
+bool World::is_pawn_valid( PawnHandle handle ) const
+{
+	return get_pawn( handle ) != nullptr;
+}
+
 void World::resize( const Vec2& size )
 {
 	_size = size;
 
+#ifndef EKOSYSTEM_HEADLESS
 	_ground->transform->set_scale(
 		Vec3 {
 			( _size.x + 1.5f ) * TILE_SIZE * 0.5f,
@@ -221,6 +690,13 @@ void World::resize( const Vec2& size )
 	);
 
 	_ground_renderer->model->get_mesh( 0 )->tiling = _size;
+#endif
+
+	//  The grid cells are stored by the chunks, so they are rebuilt after them
+	_rebuild_tile_occupancy();
+	_rebuild_pawn_grid();
+	_threat_field.resize( _tiles_width, _tiles_height, threat_field_radius, WORLD_CHUNK_SIZE );
+	_rebuild_food_fields();
 }
 
 void World::clear()
@@ -229,18 +705,112 @@ void World::clear()
 	{
 		if ( !pawn.is_valid() ) continue;
 
+		_free_pawn_slot( pawn.get() );
+		_detach_pawn_hot_state( pawn.get() );
+		pawn->_world_index = -1;
+		pawn->_grid_cell_id = -1;
+		pawn->_grid_cell_index = -1;
+		pawn->_tile_id = -1;
+		pawn->_tile_index = -1;
+		pawn->_chunk_id = -1;
+		pawn->_chunk_index = -1;
+		pawn->_is_chunk_mobile = false;
+		std::fill( std::begin( pawn->_adjective_list_ids ), std::end( pawn->_adjective_list_ids ), -1 );
+		pawn->_data_list_id = -1;
+		std::fill( std::begin( pawn->_food_field_source_ids ), std::end( pawn->_food_field_source_ids ), -1 );
+		pawn->_mate_candidate_index = -1;
+		pawn->_wake_tick = -1;
+
+		//  Unregistered beforehand, so the world is left untouched
 		pawn->kill();
 	}
 	_pawns.clear();
+	_hot_states = PawnHotStates {};
+
+	for ( auto& chunk : _chunks )
+	{
+		chunk = WorldChunk {};
+	}
+	_out_of_bounds_pawns.clear();
+	for ( auto& pawns : _pawns_by_adjective )
+	{
+		pawns.clear();
+	}
+	_pawns_by_data.clear();
+	_queries.clear();
+	_mate_candidates.clear();
+	_threat_field.clear();
+	for ( PawnDistanceField& food_field : _food_fields )
+	{
+		food_field.clear();
+	}
+
+	std::fill( std::begin( _group_counts ), std::end( _group_counts ), 0 );
+
+	_commands.clear();
+	_timer_wheel.reset( _tick );
+	_suspended_pawns_count = 0;
+	_births.clear();
+	std::fill( std::begin( _pending_births_counts ), std::end( _pending_births_counts ), 0 );
+}
+
+bool World::is_tile_occupied( const Vec3& tile_pos, Adjectives adjectives_filter ) const
+{
+	const int tile_id = _get_tile_id( tile_pos );
+	if ( tile_id == OUT_OF_BOUNDS_TILE_ID )
+	{
+		for ( const SafePtr<Pawn>& pawn : _out_of_bounds_pawns )
+		{
+			if ( pawn->get_tile_pos() != tile_pos ) continue;
+			if ( adjectives_filter != Adjectives::None && pawn->data->has_adjective( adjectives_filter ) ) continue;
+
+			return true;
+		}
+
+		return false;
+	}
+
+	const TileOccupancy* tile = _find_tile( tile_id );
+	if ( tile == nullptr || tile->pawns.empty() ) return false;
+	if ( adjectives_filter == Adjectives::None ) return true;
+
+	//  Occupied unless all occupants have the filtered adjectives
+	return ( tile->adjectives_intersection & adjectives_filter ) != adjectives_filter;
 }
 
-bool World::find_empty_tile_pos_around( const Vec3& pos, Vec3* out, Adjectives adjectives_filter ) const
+Adjectives World::get_tile_adjectives( const Vec3& tile_pos ) const
+{
+	const int tile_id = _get_tile_id( tile_pos );
+	if ( tile_id == OUT_OF_BOUNDS_TILE_ID )
+	{
+		Adjectives adjectives = Adjectives::None;
+		for ( const SafePtr<Pawn>& pawn : _out_of_bounds_pawns )
+		{
+			if ( pawn->get_tile_pos() != tile_pos ) continue;
+
+			adjectives = adjectives | pawn->data->adjectives;
+		}
+
+		return adjectives;
+	}
+
+	const TileOccupancy* tile = _find_tile( tile_id );
+	if ( tile == nullptr ) return Adjectives::None;
+
+	return tile->adjectives_union;
+}
+
+bool World::find_empty_tile_pos_around(
+	const Vec3& pos,
+	Vec3* out,
+	Adjectives adjectives_filter,
+	std::unordered_set<int>* reserved_tile_ids
+) const
 {
 	//  Randomize signs to avoid giving the same direction each time
-	int random_sign_x = random::generate_sign();
-	int random_sign_y = random::generate_sign();
+	int random_sign_x = generate_random_sign();
+	int random_sign_y = generate_random_sign();
 
-	const Box bounds = get_bounds();
 	for ( int x = -1; x <= 1; x++ )
 	{
 		for ( int y = -1; y <= 1; y++ )
@@ -251,26 +821,15 @@ bool World::find_empty_tile_pos_around( const Vec3& pos, Vec3* out, Adjectives a
 			out->x = pos.x + x * random_sign_x;
 			out->y = pos.y + y * random_sign_y;
 
-			//  Filter out any out-of-bounds positions
-			if ( out->x < bounds.min.x || out->x > bounds.max.x ) continue;
-			if ( out->y < bounds.min.y || out->y > bounds.max.y ) continue;
+			//  Filter out any position outside the chunks
+			const int tile_id = _get_tile_id( *out );
+			if ( tile_id == OUT_OF_BOUNDS_TILE_ID ) continue;
 
 			//  Filter out position already containing a pawn
-			SafePtr<Pawn> pawn = nullptr;
-			if ( adjectives_filter == Adjectives::None )
-			{
-				pawn = find_pawn_at( Adjectives::None, *out );
-			}
-			else
-			{
-				pawn = find_pawn( [&]( SafePtr<Pawn> pawn ) {
-					if ( pawn->get_tile_pos() != *out ) return false;
-					if ( pawn->data->has_adjective( adjectives_filter ) ) return false;
-					return true;
-				} );
-			}
+			if ( is_tile_occupied( *out, adjectives_filter ) ) continue;
 
-			if ( pawn.is_valid() ) continue;
+			//  Filter out position already reserved, reserving it otherwise
+			if ( reserved_tile_ids != nullptr && !reserved_tile_ids->insert( tile_id ).second ) continue;
 
 			return true;
 		}
@@ -281,22 +840,73 @@ bool World::find_empty_tile_pos_around( const Vec3& pos, Vec3* out, Adjectives a
 
 Vec3 World::find_random_tile_pos() const
 {
-	const Box bounds = get_bounds();
-	return Vec3::snap_to_grid( random::generate_location( bounds ), 1.0f );
-}
+	if ( _tiles_width == 0 || _tiles_height == 0 ) return Vec3::zero;
 
-SafePtr<Pawn> World::find_pawn_with(
-	Adjectives adjectives,
-	SafePtr<Pawn> pawn_to_ignore
-) const
-{
-	for ( auto& pawn : _pawns )
+	//  Pick a chunk, then one of its tiles. Edge chunks partially outside the bounds are
+	//  picked again when the tile is outside, so all tiles stay equally likely.
+	while ( true )
 	{
-		if ( pawn == pawn_to_ignore ) continue;
-		if ( !pawn.is_valid() ) continue;
-		if ( !pawn->data->has_adjective( adjectives ) ) continue;
-
-		return pawn;
+		const int chunk_id = generate_random( 0, static_cast<int>( _chunks.size() ) - 1 );
+		const int x = ( chunk_id % _chunks_width ) * WORLD_CHUNK_SIZE + generate_random( 0, WORLD_CHUNK_SIZE - 1 );
+		const int y = ( chunk_id / _chunks_width ) * WORLD_CHUNK_SIZE + generate_random( 0, WORLD_CHUNK_SIZE - 1 );
+		if ( x >= _tiles_width || y >= _tiles_height ) continue;
+
+		return Vec3 {
+			static_cast<float>( x + _tiles_origin_x ),
+			static_cast<float>( y + _tiles_origin_y ),
+			0.0f
+		};
+	}
+}
+
+void World::set_random_seed( uint32_t seed )
+{
+	_random_engine.seed( seed );
+}
+
+int World::generate_random( int min, int max ) const
+{
+	if ( min >= max ) return min;
+	return std::uniform_int_distribution<int>( min, max )( _random_engine );
+}
+
+float World::generate_random( float min, float max ) const
+{
+	if ( min >= max ) return min;
+	return std::uniform_real_distribution<float>( min, max )( _random_engine );
+}
+
+int World::generate_random_sign() const
+{
+	return generate_random( 0, 1 ) == 0 ? -1 : 1;
+}
+
+SafePtr<Pawn> World::find_pawn_with(
+	Adjectives adjectives,
+	SafePtr<Pawn> pawn_to_ignore
+) const
+{
+	//  Pick the smallest membership list among the required adjectives
+	const std::vector<SafePtr<Pawn>>* candidates = &_pawns;
+	for ( int bit = 0; bit < ADJECTIVES_COUNT; bit++ )
+	{
+		const Adjectives adjective = static_cast<Adjectives>( 1u << bit );
+		if ( ( adjectives & adjective ) != adjective ) continue;
+
+		const std::vector<SafePtr<Pawn>>& pawns = _pawns_by_adjective[bit];
+		if ( pawns.size() < candidates->size() )
+		{
+			candidates = &pawns;
+		}
+	}
+
+	for ( auto& pawn : *candidates )
+	{
+		if ( pawn == pawn_to_ignore ) continue;
+		if ( !pawn.is_valid() ) continue;
+		if ( !pawn->data->has_adjective( adjectives ) ) continue;
+
+		return pawn;
 	}
 
 	return nullptr;
@@ -307,7 +917,15 @@ SafePtr<Pawn> World::find_pawn_at(
 	const Vec3& pos
 ) const
 {
-	for ( auto& pawn : _pawns )
+	static const std::vector<SafePtr<Pawn>> EMPTY_PAWNS {};
+
+	const int tile_id = _get_tile_id( pos );
+	const TileOccupancy* tile = tile_id == OUT_OF_BOUNDS_TILE_ID ? nullptr : _find_tile( tile_id );
+	const std::vector<SafePtr<Pawn>>& pawns = tile_id == OUT_OF_BOUNDS_TILE_ID
+		? _out_of_bounds_pawns
+		: tile != nullptr ? tile->pawns : EMPTY_PAWNS;
+
+	for ( auto& pawn : pawns )
 	{
 		if ( !pawn.is_valid() ) continue;
 		if ( pawn->get_tile_pos() != pos ) continue;
@@ -319,44 +937,438 @@ SafePtr<Pawn> World::find_pawn_at(
 	return nullptr;
 }
 
-SafePtr<Pawn> eks::World::find_nearest_pawn(
+SafePtr<Pawn> World::find_nearest_pawn(
 	const Vec3& origin,
 	std::function<bool( SafePtr<Pawn> )> callback
 ) const
 {
-	SafePtr<Pawn> nearest_pawn = nullptr;
-	float nearest_dist = math::PLUS_INFINITY;
-	for ( auto& pawn : _pawns )
+	return find_nearest_pawn(
+		origin,
+		[&]( const SafePtr<Pawn>& pawn ) { return callback( pawn ); }
+	);
+}
+
+SafePtr<Pawn> World::find_nearest_pawn_with(
+	Adjectives adjectives,
+	const Vec3& origin,
+	std::function<bool( SafePtr<Pawn> )> callback
+) const
+{
+	return find_nearest_pawn_with(
+		adjectives, origin,
+		[&]( const SafePtr<Pawn>& pawn ) { return callback( pawn ); }
+	);
+}
+
+SafePtr<Pawn> World::find_nearest_pawn_of(
+	const PawnData* data,
+	const Vec3& origin,
+	std::function<bool( SafePtr<Pawn> )> callback
+) const
+{
+	return find_nearest_pawn_of(
+		data, origin,
+		[&]( const SafePtr<Pawn>& pawn ) { return callback( pawn ); }
+	);
+}
+
+SafePtr<Pawn> World::find_pawn( std::function<bool( SafePtr<Pawn> )> callback ) const
+{
+	return find_pawn( [&]( const SafePtr<Pawn>& pawn ) { return callback( pawn ); } );
+}
+
+SafePtr<Pawn> World::find_food_for( const Pawn* pawn ) const
+{
+	if ( const PawnQueryCacheEntry* cache = _find_query_cache( pawn, PawnQueryType::Food, 0.0f ) )
+	{
+		return cache->target;
+	}
+
+	SafePtr<Pawn> food = _find_food_for( pawn );
+	_store_query_cache( pawn, PawnQueryType::Food, 0.0f, food );
+	return food;
+}
+
+SafePtr<Pawn> World::_find_food_for( const Pawn* pawn ) const
+{
+	//  Herbivore pawns eat vegetal pawns while carnivore pawns eat meat pawns
+	Adjectives food_adjectives = Adjectives::None;
+	Adjectives eater_adjectives = Adjectives::None;
+	if ( pawn->data->has_adjective( Adjectives::Herbivore ) )
+	{
+		food_adjectives = Adjectives::Vegetal;
+		eater_adjectives = Adjectives::Herbivore;
+	}
+	else if ( pawn->data->has_adjective( Adjectives::Carnivore ) )
+	{
+		food_adjectives = Adjectives::Meat;
+		eater_adjectives = Adjectives::Carnivore;
+	}
+	else
+	{
+		return nullptr;
+	}
+
+	auto filter = [&]( const SafePtr<Pawn>& other )
+	{
+		if ( other.get() == pawn ) return false;
+		return !other->is_same_group( pawn->get_group_id() );
+	};
+
+	//  Read the nearest food from its field, which doesn't contain the pawns eating this
+	//  food, so the pawn never finds itself there
+	if ( pawn->_tile_id >= 0 )
+	{
+		const PawnDistanceField& food_field = _food_fields[_get_food_field_index( food_adjectives )];
+
+		float food_dist_sqr = 0.0f;
+		const SafePtr<Pawn> food = food_field.get_source_at( pawn->_tile_id, food_field_radius, &food_dist_sqr );
+		if ( food.is_valid() && filter( food ) )
+		{
+			//  Look for nearer food amongst the pawns excluded from the field
+			const SafePtr<Pawn> nearer_food = find_nearest_pawn_in_radius(
+				pawn->get_tile_pos(),
+				std::sqrt( food_dist_sqr ),
+				filter,
+				food_adjectives | eater_adjectives
+			);
+			if ( nearer_food.is_valid() ) return nearer_food;
+
+			return food;
+		}
+	}
+
+	return find_nearest_pawn_with( food_adjectives, pawn->get_tile_pos(), filter );
+}
+
+SafePtr<Pawn> World::find_mate_for( const Pawn* pawn ) const
+{
+	return find_nearest_pawn_of(
+		pawn->data.get(),
+		pawn->get_tile_pos(),
+		[&]( const SafePtr<Pawn>& other )
+		{
+			if ( other.get() == pawn ) return false;
+			return other->wants_to_mate();
+		}
+	);
+}
+
+SafePtr<Pawn> World::find_threat_for( const Pawn* pawn, float radius ) const
+{
+	if ( const PawnQueryCacheEntry* cache = _find_query_cache( pawn, PawnQueryType::Threat, radius ) )
+	{
+		return cache->target;
+	}
+
+	SafePtr<Pawn> threat = _find_threat_for( pawn, radius );
+	_store_query_cache( pawn, PawnQueryType::Threat, radius, threat );
+	return threat;
+}
+
+int World::get_query_cache_hits() const
+{
+	return _query_cache_hits;
+}
+
+int World::get_query_cache_misses() const
+{
+	return _query_cache_misses;
+}
+
+void World::reset_query_cache_stats()
+{
+	_query_cache_hits = 0;
+	_query_cache_misses = 0;
+}
+
+SafePtr<Pawn> World::_find_threat_for( const Pawn* pawn, float radius ) const
+{
+	//  Prey read their threat from the field instead of searching around them
+	if ( _is_threat_field_prey( pawn ) && radius <= threat_field_radius && pawn->_tile_id >= 0 )
+	{
+		return get_threat_at( pawn->get_tile_pos(), radius );
+	}
+
+	//  Meat pawns only flee from carnivores
+	const Adjectives threat_adjectives = pawn->data->has_adjective( Adjectives::Meat )
+									   ? Adjectives::Carnivore
+									   : Adjectives::None;
+
+	return find_nearest_pawn_in_radius(
+		pawn->get_tile_pos(),
+		radius,
+		[&]( const SafePtr<Pawn>& other )
+		{
+			if ( other.get() == pawn ) return false;
+			return other->data != pawn->data;
+		},
+		threat_adjectives
+	);
+}
+
+void World::rebuild_threat_field()
+{
+	//  Only clear the tiles reached by the previous rebuild, unless the radius was changed
+	if ( _threat_field.get_max_distance() != threat_field_radius )
+	{
+		_threat_field.resize( _tiles_width, _tiles_height, threat_field_radius, WORLD_CHUNK_SIZE );
+	}
+	else
+	{
+		_threat_field.clear();
+	}
+
+	//  Seed the field with all carnivores, ignoring out-of-bounds ones
+	for ( const SafePtr<Pawn>& pawn : get_pawns_with( Adjectives::Carnivore ) )
+	{
+		if ( pawn->_tile_id < 0 ) continue;
+
+		_threat_field.add_source( pawn, pawn->_tile_id );
+	}
+
+	_threat_field.propagate();
+}
+
+SafePtr<Pawn> World::get_threat_at( const Vec3& tile_pos, float radius ) const
+{
+	return _threat_field.get_source_at( _get_tile_id( tile_pos ), radius );
+}
+
+Vec3 World::get_threat_flee_direction( const Pawn* pawn ) const
+{
+	if ( !_is_threat_field_prey( pawn ) ) return Vec3::zero;
+
+	return _threat_field.get_gradient_at( _get_tile_id( pawn->get_tile_pos() ) );
+}
+
+Vec3 World::get_food_direction( Adjectives food_adjective, const Vec3& tile_pos ) const
+{
+	const int index = _get_food_field_index( food_adjective );
+	if ( index == -1 ) return Vec3::zero;
+
+	return -_food_fields[index].get_gradient_at( _get_tile_id( tile_pos ) );
+}
+
+void World::request_query( const Pawn* requester, PawnQueryType type, float radius ) const
+{
+	//  Food and threat queries are run when needed if not batched
+	if ( !is_query_batch_enabled && type != PawnQueryType::Mate ) return;
+
+	requester->_requested_queries_mask |= 1 << static_cast<uint8>( type );
+	requester->_requested_query_radii[static_cast<uint8>( type )] = radius;
+}
+
+int64_t World::get_batched_queries_count() const
+{
+	return _batched_queries_count;
+}
+
+void World::resolve_queries()
+{
+	//  Gather the queries of the pawns ticked at this step, the other ones are kept for their next tick
+	for ( const SafePtr<Pawn>& pawn : _pawns )
 	{
-		if ( callback( pawn ) )
+		if ( pawn->_requested_queries_mask == 0 ) continue;
+
+		if ( pawn->is_killed() )
+		{
+			pawn->_requested_queries_mask = 0;
+			continue;
+		}
+
+		const bool is_ticked = !is_pawn_dormant( pawn.get() )
+							&& !pawn->is_suspended()
+							&& ( _is_ai_lod_tick( pawn.get() ) || pawn->_is_tick_deferred );
+		for ( uint8 type = 0; type < PAWN_QUERY_TYPES_COUNT; type++ )
 		{
-			float dist = Vec3::distance2d_sqr(
-				origin,
-				pawn->get_tile_pos()
+			const uint8 type_mask = 1 << type;
+			if ( !( pawn->_requested_queries_mask & type_mask ) ) continue;
+
+			//  Mates are paired right away so the partner of a pawn skipped by its AI level of detail
+			//  isn't kept waiting
+			const PawnQueryType query_type = static_cast<PawnQueryType>( type );
+			if ( query_type != PawnQueryType::Mate && !is_ticked ) continue;
+
+			pawn->_requested_queries_mask &= ~type_mask;
+			_queries.push_back(
+				PawnQuery {
+					.requester = pawn->get_handle(),
+					.type = query_type,
+					.radius = pawn->_requested_query_radii[type],
+					.cell_id = pawn->_grid_cell_id,
+				}
 			);
+		}
+	}
+	if ( _queries.empty() ) return;
+
+	//  Sort the queries by grid cell so consecutive searches visit the same cells, the handles
+	//  keep the order independent from the pawns list
+	std::sort(
+		_queries.begin(), _queries.end(),
+		[]( const PawnQuery& a, const PawnQuery& b )
+		{
+			if ( a.cell_id != b.cell_id ) return a.cell_id < b.cell_id;
+			if ( a.requester.value != b.requester.value ) return a.requester.value < b.requester.value;
+			return a.type < b.type;
+		}
+	);
 
-			if ( nearest_pawn == nullptr || nearest_dist > dist )
+	//  Search in parallel, the searches only write to the cache of their requester
+	const int queries_count = static_cast<int>( _queries.size() );
+	_parallel_for( queries_count, QUERY_BATCH_SIZE,
+		[&]( int begin, int end )
+		{
+			for ( int i = begin; i < end; i++ )
 			{
-				nearest_pawn = pawn;
-				nearest_dist = dist;
+				const PawnQuery& query = _queries[i];
+				const Pawn* requester = get_pawn( query.requester );
+				if ( requester == nullptr ) continue;
+
+				switch ( query.type )
+				{
+					case PawnQueryType::Food:
+						_store_query_cache( requester, query.type, query.radius, _find_food_for( requester ) );
+						break;
+					case PawnQueryType::Threat:
+						_store_query_cache( requester, query.type, query.radius, _find_threat_for( requester, query.radius ) );
+						break;
+					case PawnQueryType::Mate:
+						break;
+				}
 			}
 		}
+	);
+
+	//  Pair the mates in order since each pairing writes to both partners
+	for ( const PawnQuery& query : _queries )
+	{
+		if ( query.type != PawnQueryType::Mate ) continue;
+
+		if ( Pawn* requester = get_pawn( query.requester ) )
+		{
+			_match_mate( requester );
+		}
 	}
 
-	return nearest_pawn;
+	_batched_queries_count += queries_count;
+	_queries.clear();
 }
 
-SafePtr<Pawn> World::find_pawn( std::function<bool( SafePtr<Pawn> )> callback ) const
+void World::_match_mate( Pawn* pawn )
 {
-	for ( auto& pawn : _pawns )
+	//  Paired candidates stay registered until they stop looking for a mate,
+	//  so they are skipped by checking their partner
+	if ( pawn->_mate_candidate_index == -1 || is_pawn_valid( pawn->partner_pawn ) ) return;
+
+	const PawnData* data = pawn->data.get();
+	const std::vector<SafePtr<Pawn>>& candidates = _mate_candidates[data];
+	if ( candidates.size() < 2 ) return;
+
+	auto filter = [&]( const SafePtr<Pawn>& other )
+	{
+		if ( other.get() == pawn ) return false;
+		if ( other->_mate_candidate_index == -1 || other->data.get() != data ) return false;
+		return !is_pawn_valid( other->partner_pawn );
+	};
+
+	//  Scan the candidates when they are few, search the grid otherwise
+	const bool should_scan = candidates.size() * candidates.size() <= _pawns.size();
+	const SafePtr<Pawn> mate_pawn = should_scan
+		? _find_nearest_pawn_in_list( candidates, pawn->get_tile_pos(), filter, math::PLUS_INFINITY )
+		: _find_nearest_pawn_in_grid( pawn->get_tile_pos(), filter, math::PLUS_INFINITY );
+	if ( !mate_pawn.is_valid() ) return;
+
+	pawn->partner_pawn = mate_pawn->get_handle();
+	mate_pawn->partner_pawn = pawn->get_handle();
+}
+
+void World::refresh_pawn_data_adjectives( const PawnData* data )
+{
+	auto itr = _pawns_by_data.find( data );
+	if ( itr == _pawns_by_data.end() ) return;
+
+	for ( const SafePtr<Pawn>& pawn : itr->second )
 	{
-		if ( callback( pawn ) )
+		_remove_pawn_from_adjective_lists( pawn.get() );
+		_add_pawn_to_adjective_lists( pawn );
+
+		if ( pawn->_tile_id >= 0 )
 		{
-			return pawn;
+			_refresh_tile_adjectives( _get_or_create_tile( pawn->_tile_id ) );
 		}
+
+		_remove_pawn_from_food_fields( pawn.get() );
+		_add_pawn_to_food_fields( pawn );
 	}
+}
 
-	return nullptr;
+void World::on_pawn_tile_pos_changed( Pawn* pawn )
+{
+	//  Pawns are registered by World::create_pawn after their initial placement, and
+	//  unregistered by World::on_pawn_killed
+	if ( !_is_pawn_registered( pawn ) || pawn->is_killed() ) return;
+
+	if ( _get_tile_id( pawn->get_tile_pos() ) != pawn->_tile_id )
+	{
+		_add_pawn_to_tile( _remove_pawn_from_tile( pawn ) );
+
+		_remove_pawn_from_food_fields( pawn );
+		_add_pawn_to_food_fields( _pawns[pawn->_world_index] );
+	}
+
+	const int cell_id = _get_grid_cell_id( pawn->get_tile_pos() );
+	if ( cell_id == pawn->_grid_cell_id ) return;
+
+	//  Move the reference from its previous cell to its new one
+	_add_pawn_to_grid( _remove_pawn_from_grid( pawn ) );
+}
+
+void World::on_pawn_group_id_changed( Pawn* pawn, GroupID previous_group_id )
+{
+	//  Pawns are counted by World::create_pawn once registered, and until killed
+	if ( !_is_pawn_registered( pawn ) || pawn->is_killed() ) return;
+
+	_group_counts[previous_group_id]--;
+	_group_counts[pawn->get_group_id()]++;
+}
+
+void World::on_pawn_wants_to_mate_changed( Pawn* pawn )
+{
+	if ( !_is_pawn_registered( pawn ) || pawn->is_killed() ) return;
+
+	if ( pawn->wants_to_mate() )
+	{
+		if ( pawn->_mate_candidate_index != -1 ) return;
+
+		std::vector<SafePtr<Pawn>>& candidates = _mate_candidates[pawn->data.get()];
+		pawn->_mate_candidate_index = static_cast<int>( candidates.size() );
+		candidates.push_back( _pawns[pawn->_world_index] );
+	}
+	else
+	{
+		if ( pawn->_mate_candidate_index == -1 ) return;
+
+		_swap_and_pop_pawn( _mate_candidates[pawn->data.get()], pawn->_mate_candidate_index, &Pawn::_mate_candidate_index );
+		pawn->_mate_candidate_index = -1;
+	}
+}
+
+void World::on_pawn_killed( Pawn* pawn )
+{
+	if ( !_is_pawn_registered( pawn ) ) return;
+
+	_unregister_pawn_references( pawn );
+
+	//  The commit phase is iterating the pawns list, so remove the pawn right after it
+	if ( _is_ticking_pawns )
+	{
+		_killed_pawns.push_back( pawn );
+		return;
+	}
+
+	_remove_pawn( pawn );
 }
 
 Vec3 World::world_to_grid( const Vec3& world_pos ) const
@@ -382,6 +1394,30 @@ const std::vector<SafePtr<Pawn>>& World::get_pawns() const
 	return _pawns;
 }
 
+const std::vector<SafePtr<Pawn>>& World::get_pawns_with( Adjectives adjective ) const
+{
+	for ( int bit = 0; bit < ADJECTIVES_COUNT; bit++ )
+	{
+		if ( adjective == static_cast<Adjectives>( 1u << bit ) )
+		{
+			return _pawns_by_adjective[bit];
+		}
+	}
+
+	ASSERT_MSG( false, "World::get_pawns_with only supports single-bit adjectives!" );
+	return _pawns;
+}
+
+const std::vector<SafePtr<Pawn>>& World::get_pawns_of( const PawnData* data ) const
+{
+	static const std::vector<SafePtr<Pawn>> EMPTY_PAWNS {};
+
+	auto itr = _pawns_by_data.find( data );
+	if ( itr == _pawns_by_data.end() ) return EMPTY_PAWNS;
+
+	return itr->second;
+}
+
 const std::map<std::string, SharedPtr<PawnData>>& World::get_pawn_datas() const
 {
 	return _pawn_datas;
@@ -399,11 +1435,26 @@ Vec2 World::get_size() const
 
 Box World::get_bounds() const
 {
-	//	TODO: Fix the callers using this function giving weird results with an odd-sized world
+	//	NOTE: Its corners are not on tiles with an odd-sized world, see World::get_tile_bounds
 	const Vec3 half_size( _size * 0.5f, 0.0f );
 	return Box { -half_size, half_size };
 }
 
+Box World::get_tile_bounds() const
+{
+	const Vec3 min {
+		static_cast<float>( _tiles_origin_x ),
+		static_cast<float>( _tiles_origin_y ),
+		0.0f
+	};
+	const Vec3 max {
+		static_cast<float>( _tiles_origin_x + math::max( _tiles_width, 1 ) - 1 ),
+		static_cast<float>( _tiles_origin_y + math::max( _tiles_height, 1 ) - 1 ),
+		0.0f
+	};
+	return Box { min, max };
+}
+
 Vec3 World::get_sun_direction() const
 {
 	return _sun_direction;
@@ -430,29 +1481,153 @@ float World::get_world_time() const
 	return _world_time;
 }
 
-void World::_init_datas()
+int World::get_tick() const
 {
-	// Sleep particle system
-	SharedPtr<ParticleSystemData> sleep_particle_system = std::make_shared<ParticleSystemData>( 
-		ParticleSystemData {
-			.mesh = Assets::get_model( "ekosystem::facing.plane" )->get_mesh( 0 ),
-			.shader = Assets::get_shader( "suprengine::texture" ),
-			.texture = Assets::get_texture( "ekosystem::icon.sleep" ),
-			.render_scale = Vec3( 1.0f ),
-			.start_velocity = Vec3 { 1.5f, -1.5f, 1.5f },
-			.spawn_location_offset = Vec3 { 0.0f, 0.0f, 5.0f },
-			.custom_updater = [&]( ParticleInstance* particle, ParticleRenderer* renderer, float dt )
-			{
-				const SharedPtr<Curve> alpha_curve = Assets::get_curve( "particles/sleep-alpha" );
-				const SharedPtr<Curve> scale_curve = Assets::get_curve( "particles/sleep-scale" );
+	return _tick;
+}
 
-				//	Offset
-				particle->offset.x = 0.08f * math::sin( ( particle->unique_id * 2.0f + particle->lifetime ) * 3.0f );
-				particle->offset.y = -0.16f * math::cos( ( particle->unique_id * 2.0f + particle->lifetime ) * 3.0f );
+void World::suspend_pawn( Pawn* pawn, float duration )
+{
+	if ( !is_timer_wheel_enabled || pawn->is_suspended() ) return;
 
-				//	Modulate & Scale
-				const float time = particle->lifetime / renderer->system_data->max_lifetime;
-				particle->modulate.a = static_cast<uint8>( alpha_curve->evaluate_by_time( time ) * 255.0f );
+	//  Round to the nearest step rather than up to absorb the float errors of the accumulated time,
+	//  a pawn woken up a step early is suspended again for the rest
+	const int ticks_count = math::clamp(
+		static_cast<int>( std::round( duration / fixed_timestep ) ),
+		1, PawnTimerWheel::MAX_DELAY_TICKS
+	);
+	pawn->_wake_tick = _tick + ticks_count;
+	_timer_wheel.schedule(
+		PawnTimer {
+			.handle = pawn->get_handle(),
+			.wake_tick = pawn->_wake_tick,
+		}
+	);
+	_suspended_pawns_count++;
+}
+
+void World::wake_pawn( Pawn* pawn, bool is_interrupted )
+{
+	if ( !pawn->is_suspended() ) return;
+
+	pawn->_wake_tick = -1;
+	_suspended_pawns_count--;
+
+	if ( !is_interrupted || pawn->_state_machine == nullptr ) return;
+
+	if ( State<Pawn>* state = pawn->_state_machine->get_current_state() )
+	{
+		if ( StateTask<Pawn>* task = state->get_current_task() )
+		{
+			task->finish( StateTaskResult::Failed );
+		}
+	}
+}
+
+int World::get_suspended_pawns_count() const
+{
+	return _suspended_pawns_count;
+}
+
+void World::set_ai_lod_focus( const Vec3& tile_pos )
+{
+	_ai_lod_focus = tile_pos;
+	_has_ai_lod_focus = true;
+}
+
+void World::clear_ai_lod_focus()
+{
+	_has_ai_lod_focus = false;
+}
+
+bool World::has_ai_lod_focus() const
+{
+	return _has_ai_lod_focus;
+}
+
+float World::get_ai_budget_spent_us() const
+{
+	return _ai_budget_spent_us;
+}
+
+int World::get_ai_backlog_count() const
+{
+	return _ai_backlog_count;
+}
+
+float World::get_ai_lag() const
+{
+	return _ai_lag + _ai_backlog_time;
+}
+
+int World::get_pawns_count_in_ai_lod( PawnAILod ai_lod ) const
+{
+	int count = 0;
+	for ( const SafePtr<Pawn>& pawn : _pawns )
+	{
+		if ( pawn->_ai_lod != ai_lod ) continue;
+
+		count++;
+	}
+
+	return count;
+}
+
+JobSystem* World::get_job_system() const
+{
+	return _job_system;
+}
+
+void World::_parallel_for( int count, int batch_size, const JobSystem::RangeFunction& function ) const
+{
+	if ( _job_system == nullptr )
+	{
+		function( 0, count );
+		return;
+	}
+
+	_job_system->parallel_for( count, batch_size, function );
+}
+
+int World::get_fixed_steps_count() const
+{
+	return _fixed_steps_count;
+}
+
+int64_t World::get_pawn_ticks_count() const
+{
+	return _pawn_ticks_count;
+}
+
+float World::get_fixed_step_alpha() const
+{
+	return math::clamp( _fixed_time_accumulator / fixed_timestep, 0.0f, 1.0f );
+}
+
+void World::_init_datas()
+{
+#ifndef EKOSYSTEM_HEADLESS
+	// Sleep particle system
+	SharedPtr<ParticleSystemData> sleep_particle_system = std::make_shared<ParticleSystemData>( 
+		ParticleSystemData {
+			.mesh = Assets::get_model( "ekosystem::facing.plane" )->get_mesh( 0 ),
+			.shader = Assets::get_shader( "suprengine::texture" ),
+			.texture = Assets::get_texture( "ekosystem::icon.sleep" ),
+			.render_scale = Vec3( 1.0f ),
+			.start_velocity = Vec3 { 1.5f, -1.5f, 1.5f },
+			.spawn_location_offset = Vec3 { 0.0f, 0.0f, 5.0f },
+			.custom_updater = [&]( ParticleInstance* particle, ParticleRenderer* renderer, float dt )
+			{
+				const SharedPtr<Curve> alpha_curve = Assets::get_curve( "particles/sleep-alpha" );
+				const SharedPtr<Curve> scale_curve = Assets::get_curve( "particles/sleep-scale" );
+
+				//	Offset
+				particle->offset.x = 0.08f * math::sin( ( particle->unique_id * 2.0f + particle->lifetime ) * 3.0f );
+				particle->offset.y = -0.16f * math::cos( ( particle->unique_id * 2.0f + particle->lifetime ) * 3.0f );
+
+				//	Modulate & Scale
+				const float time = particle->lifetime / renderer->system_data->max_lifetime;
+				particle->modulate.a = static_cast<uint8>( alpha_curve->evaluate_by_time( time ) * 255.0f );
 				particle->scale = scale_curve->evaluate_by_time( time );
 			},
 			.spawn_rate = 1.0f,
@@ -495,6 +1670,7 @@ void World::_init_datas()
 			.max_lifetime = 3.0f,
 		}
 	);
+#endif
 
 	//  Load all pawn data files
 	std::filesystem::directory_iterator itr( "assets/ekosystem/data/pawns/" );
@@ -520,22 +1696,650 @@ void World::_init_datas()
 		//  Unserialize JSON to game data
 		auto data = std::make_shared<PawnData>();
 		data->name = file_path.filename().replace_extension().string();
+	#ifndef EKOSYSTEM_HEADLESS
 		data->sleep_particle_system = sleep_particle_system;
 		data->love_particle_system = love_particle_system;
+	#endif
 		data->unserialize( doc );
 		add_pawn_data( data );
 	}
 }
 
-void World::_on_entity_removed( Entity* entity )
+bool World::_is_pawn_registered( const Pawn* pawn )
+{
+	return pawn->_world_index != -1;
+}
+
+void World::_remove_pawn( Pawn* pawn )
+{
+	_detach_pawn_hot_state( pawn );
+
+	//  Move the hot state of the last pawn along with it
+	const int index = pawn->_world_index;
+	const int last_index = static_cast<int>( _pawns.size() ) - 1;
+	_hot_states.tile_positions[index] = _hot_states.tile_positions[last_index];
+	_hot_states.hungers[index] = _hot_states.hungers[last_index];
+	_hot_states.state_ids[index] = _hot_states.state_ids[last_index];
+	_hot_states.tile_positions.pop_back();
+	_hot_states.hungers.pop_back();
+	_hot_states.state_ids.pop_back();
+
+	_swap_and_pop_pawn( _pawns, index, &Pawn::_world_index );
+	pawn->_world_index = -1;
+}
+
+void World::_attach_pawn_hot_state( Pawn* pawn )
+{
+	ASSERT_MSG( pawn->_world_index == static_cast<int>( _hot_states.hungers.size() ), "Hot states are out of sync with the pawns list" );
+
+	_hot_states.tile_positions.push_back( pawn->_tile_pos );
+	_hot_states.hungers.push_back( pawn->_hunger );
+	_hot_states.state_ids.push_back( pawn->_state_id );
+}
+
+void World::_detach_pawn_hot_state( Pawn* pawn ) const
+{
+	const int index = pawn->_world_index;
+	pawn->_tile_pos = _hot_states.tile_positions[index];
+	pawn->_hunger = _hot_states.hungers[index];
+	pawn->_state_id = _hot_states.state_ids[index];
+}
+
+void World::_reorder_pawns_by_morton()
 {
-	if ( auto pawn = entity->cast<Pawn>() )
+	const int pawns_count = static_cast<int>( _pawns.size() );
+	if ( pawns_count == 0 ) return;
+
+	//  Keep the pawn the budgeted commit phase resumes from
+	const PawnHandle cursor_handle = _pawns[_ai_budget_cursor % pawns_count]->get_handle();
+
+	//  Sort by Z-order code, then by handle for a deterministic order between pawns of the same tile
+	_morton_keys.resize( _pawns.size() );
+	for ( int i = 0; i < pawns_count; i++ )
+	{
+		const uint64_t code = _get_morton_code( _hot_states.tile_positions[i] );
+		_morton_keys[i] = { code << 32 | _pawns[i]->get_handle().value, i };
+	}
+	std::sort( _morton_keys.begin(), _morton_keys.end() );
+
+	//  Remap the pawns and their hot state to their sorted index, the handles still resolve
+	//  to the same pawns through their slots
+	std::vector<SafePtr<Pawn>> pawns( _pawns.size() );
+	PawnHotStates hot_states {};
+	hot_states.tile_positions.resize( _pawns.size() );
+	hot_states.hungers.resize( _pawns.size() );
+	hot_states.state_ids.resize( _pawns.size() );
+	for ( int i = 0; i < pawns_count; i++ )
 	{
-		auto itr = std::find( _pawns.begin(), _pawns.end(), SafePtr<Pawn>( pawn ) );
-		ASSERT_MSG( itr != _pawns.end(), "A removed pawn couldn't be erased from the World pawns list!" );
+		const int previous_index = _morton_keys[i].second;
+		pawns[i] = std::move( _pawns[previous_index] );
+		pawns[i]->_world_index = i;
 
-		_pawns.erase( itr );
+		hot_states.tile_positions[i] = _hot_states.tile_positions[previous_index];
+		hot_states.hungers[i] = _hot_states.hungers[previous_index];
+		hot_states.state_ids[i] = _hot_states.state_ids[previous_index];
+	}
+	_pawns = std::move( pawns );
+	_hot_states = std::move( hot_states );
 
-		printf( "Pawn '%s' is being removed!\n", pawn->get_name().c_str() );
+	_ai_budget_cursor = get_pawn( cursor_handle )->_world_index;
+}
+
+uint32_t World::_get_morton_code( const Vec3& tile_pos ) const
+{
+	//  Spread the lower 16 bits of the value to the even bits
+	auto spread_bits = []( uint32_t value )
+	{
+		value &= 0x0000FFFF;
+		value = ( value | ( value << 8 ) ) & 0x00FF00FF;
+		value = ( value | ( value << 4 ) ) & 0x0F0F0F0F;
+		value = ( value | ( value << 2 ) ) & 0x33333333;
+		value = ( value | ( value << 1 ) ) & 0x55555555;
+		return value;
+	};
+
+	//  Interleave the tile coordinates, relative to the first tile of the world
+	const int x = math::clamp( static_cast<int>( math::floor( tile_pos.x + 0.5f ) ) - _tiles_origin_x, 0, 0xFFFF );
+	const int y = math::clamp( static_cast<int>( math::floor( tile_pos.y + 0.5f ) ) - _tiles_origin_y, 0, 0xFFFF );
+	return spread_bits( static_cast<uint32_t>( x ) ) | ( spread_bits( static_cast<uint32_t>( y ) ) << 1 );
+}
+
+void World::_unregister_pawn_references( Pawn* pawn )
+{
+	_free_pawn_slot( pawn );
+	_group_counts[pawn->get_group_id()]--;
+	_remove_pawn_from_grid( pawn );
+	_remove_pawn_from_tile( pawn );
+	_remove_pawn_from_lists( pawn );
+	_remove_pawn_from_food_fields( pawn );
+	if ( pawn->_mate_candidate_index != -1 )
+	{
+		_swap_and_pop_pawn( _mate_candidates[pawn->data.get()], pawn->_mate_candidate_index, &Pawn::_mate_candidate_index );
+		pawn->_mate_candidate_index = -1;
 	}
+
+	//  Stale timers are ignored once expired
+	if ( pawn->is_suspended() )
+	{
+		pawn->_wake_tick = -1;
+		_suspended_pawns_count--;
+	}
+}
+
+SafePtr<Pawn> World::_swap_and_pop_pawn(
+	std::vector<SafePtr<Pawn>>& pawns,
+	int index,
+	int Pawn::* index_member
+)
+{
+	ASSERT_MSG( 0 <= index && index < pawns.size(), "Index 'index' is out-of-range" );
+
+	SafePtr<Pawn> removed_pawn = std::move( pawns[index] );
+	if ( index != static_cast<int>( pawns.size() ) - 1 )
+	{
+		pawns[index] = std::move( pawns.back() );
+		( pawns[index].get()->*index_member ) = index;
+	}
+	pawns.pop_back();
+
+	return removed_pawn;
+}
+
+PawnHandle World::_allocate_pawn_slot( Pawn* pawn )
+{
+	uint32_t index = 0;
+	if ( !_free_pawn_slots.empty() )
+	{
+		index = _free_pawn_slots.back();
+		_free_pawn_slots.pop_back();
+	}
+	else
+	{
+		ASSERT_MSG( _pawn_slots.size() <= PawnHandle::INDEX_MASK, "Too many pawns for the pawn handles!" );
+
+		index = static_cast<uint32_t>( _pawn_slots.size() );
+		_pawn_slots.emplace_back();
+	}
+
+	PawnSlot& slot = _pawn_slots[index];
+	slot.pawn = pawn;
+	return PawnHandle( index, slot.generation );
+}
+
+void World::_free_pawn_slot( Pawn* pawn )
+{
+	if ( pawn->_handle.is_null() ) return;
+
+	//  Change the generation to invalidate all handles to this pawn, skipping zero
+	PawnSlot& slot = _pawn_slots[pawn->_handle.get_index()];
+	slot.pawn = nullptr;
+	slot.generation = ( slot.generation + 1 ) & PawnHandle::GENERATION_MASK;
+	if ( slot.generation == 0 )
+	{
+		slot.generation = 1;
+	}
+
+	_free_pawn_slots.push_back( pawn->_handle.get_index() );
+	pawn->_handle = PawnHandle {};
+}
+
+void World::_rebuild_pawn_grid()
+{
+	//  Cells cover the tiles, at least one cell is kept for the pawns of a world without tiles
+	_pawn_grid_width = ( math::max( _tiles_width, 1 ) + PAWN_GRID_CELL_SIZE - 1 ) / PAWN_GRID_CELL_SIZE;
+	_pawn_grid_height = ( math::max( _tiles_height, 1 ) + PAWN_GRID_CELL_SIZE - 1 ) / PAWN_GRID_CELL_SIZE;
+
+	for ( WorldChunk& chunk : _chunks )
+	{
+		chunk.grid_cells.clear();
+		chunk.grid_pawns_count = 0;
+	}
+
+	for ( const SafePtr<Pawn>& pawn : _pawns )
+	{
+		pawn->_grid_cell_id = -1;
+		pawn->_grid_cell_index = -1;
+		_add_pawn_to_grid( pawn );
+	}
+}
+
+void World::_add_pawn_to_grid( const SafePtr<Pawn>& pawn )
+{
+	ASSERT_MSG( pawn->_grid_cell_id == -1, "A pawn is already registered in the World grid!" );
+
+	int cell_x = 0, cell_y = 0;
+	_get_grid_cell_coords( pawn->get_tile_pos(), &cell_x, &cell_y );
+
+	int local_id = 0;
+	WorldChunk& chunk = _chunks[_get_grid_cell_chunk_id( cell_x, cell_y, &local_id )];
+	if ( chunk.grid_cells.empty() )
+	{
+		chunk.grid_cells.resize( CHUNK_GRID_SIZE * CHUNK_GRID_SIZE );
+	}
+	chunk.grid_pawns_count++;
+
+	std::vector<SafePtr<Pawn>>& cell = chunk.grid_cells[local_id];
+	pawn->_grid_cell_id = cell_y * _pawn_grid_width + cell_x;
+	pawn->_grid_cell_index = static_cast<int>( cell.size() );
+	cell.push_back( pawn );
+}
+
+SafePtr<Pawn> World::_remove_pawn_from_grid( Pawn* pawn )
+{
+	if ( pawn->_grid_cell_id == -1 ) return nullptr;
+
+	int local_id = 0;
+	WorldChunk& chunk = _chunks[_get_grid_cell_chunk_id(
+		pawn->_grid_cell_id % _pawn_grid_width,
+		pawn->_grid_cell_id / _pawn_grid_width,
+		&local_id
+	)];
+	SafePtr<Pawn> removed_pawn = _swap_and_pop_pawn(
+		chunk.grid_cells[local_id],
+		pawn->_grid_cell_index,
+		&Pawn::_grid_cell_index
+	);
+	chunk.grid_pawns_count--;
+
+	pawn->_grid_cell_id = -1;
+	pawn->_grid_cell_index = -1;
+	return removed_pawn;
+}
+
+void World::_get_grid_cell_coords( const Vec3& tile_pos, int* out_x, int* out_y ) const
+{
+	//  NOTE: Out-of-bounds positions (e.g. after shrinking the world) are clamped
+	//  to the edge cells, which keeps the nearest queries distance bounds valid.
+	const int tile_x = static_cast<int>( math::floor( tile_pos.x + 0.5f ) ) - _tiles_origin_x;
+	const int tile_y = static_cast<int>( math::floor( tile_pos.y + 0.5f ) ) - _tiles_origin_y;
+	*out_x = math::clamp( tile_x, 0, math::max( _tiles_width, 1 ) - 1 ) / PAWN_GRID_CELL_SIZE;
+	*out_y = math::clamp( tile_y, 0, math::max( _tiles_height, 1 ) - 1 ) / PAWN_GRID_CELL_SIZE;
+}
+
+int World::_get_grid_cell_id( const Vec3& tile_pos ) const
+{
+	int x = 0, y = 0;
+	_get_grid_cell_coords( tile_pos, &x, &y );
+	return y * _pawn_grid_width + x;
+}
+
+int World::_get_grid_cell_chunk_id( int cell_x, int cell_y, int* out_local_id ) const
+{
+	*out_local_id = ( cell_y % CHUNK_GRID_SIZE ) * CHUNK_GRID_SIZE + cell_x % CHUNK_GRID_SIZE;
+	return ( cell_y / CHUNK_GRID_SIZE ) * _chunks_width + cell_x / CHUNK_GRID_SIZE;
+}
+
+const std::vector<SafePtr<Pawn>>& World::_get_grid_cell( int cell_x, int cell_y ) const
+{
+	static const std::vector<SafePtr<Pawn>> EMPTY_CELL {};
+
+	int local_id = 0;
+	const WorldChunk& chunk = _chunks[_get_grid_cell_chunk_id( cell_x, cell_y, &local_id )];
+	if ( chunk.grid_cells.empty() ) return EMPTY_CELL;
+
+	return chunk.grid_cells[local_id];
+}
+
+void World::_update_chunks( float dt )
+{
+	for ( WorldChunk& chunk : _chunks )
+	{
+		//  Release the storage of the chunks left without pawns
+		if ( chunk.grid_pawns_count == 0 && !chunk.grid_cells.empty() )
+		{
+			std::vector<std::vector<SafePtr<Pawn>>>().swap( chunk.grid_cells );
+		}
+		if ( chunk.pawns.empty() )
+		{
+			if ( !chunk.tiles.empty() )
+			{
+				std::vector<TileOccupancy>().swap( chunk.tiles );
+			}
+
+			chunk.dormant_time = 0.0f;
+			continue;
+		}
+
+		const bool is_dormant = is_chunk_dormancy_enabled && chunk.mobile_pawns_count == 0;
+		if ( is_dormant )
+		{
+			chunk.dormant_time += dt;
+			if ( chunk.dormant_time < dormant_chunk_update_period ) continue;
+		}
+		else if ( chunk.dormant_time <= 0.0f )
+		{
+			continue;
+		}
+
+		//  Advance the pawns over the elapsed time, also catching up awoken chunks.
+		//  NOTE: Killed pawns are removed from their chunk by swapping in the last pawn, so
+		//  the chunk is iterated backward to only move already ticked pawns.
+		const float elapsed_time = chunk.dormant_time;
+		chunk.dormant_time = 0.0f;
+
+		for ( int i = static_cast<int>( chunk.pawns.size() ) - 1; i >= 0; i-- )
+		{
+			const SafePtr<Pawn> pawn = chunk.pawns[i];
+			pawn->coarse_tick( elapsed_time );
+			_pawn_ticks_count++;
+		}
+	}
+}
+
+void World::_add_pawn_to_chunk( const SafePtr<Pawn>& pawn, int chunk_id )
+{
+	WorldChunk& chunk = _chunks[chunk_id];
+	pawn->_chunk_id = chunk_id;
+	pawn->_chunk_index = static_cast<int>( chunk.pawns.size() );
+	chunk.pawns.push_back( pawn );
+
+	pawn->_is_chunk_mobile = pawn->data->move_speed > 0.0f;
+	if ( pawn->_is_chunk_mobile )
+	{
+		chunk.mobile_pawns_count++;
+	}
+}
+
+void World::_remove_pawn_from_chunk( Pawn* pawn )
+{
+	if ( pawn->_chunk_id == -1 ) return;
+
+	WorldChunk& chunk = _chunks[pawn->_chunk_id];
+	_swap_and_pop_pawn( chunk.pawns, pawn->_chunk_index, &Pawn::_chunk_index );
+	if ( pawn->_is_chunk_mobile )
+	{
+		chunk.mobile_pawns_count--;
+	}
+
+	pawn->_chunk_id = -1;
+	pawn->_chunk_index = -1;
+	pawn->_is_chunk_mobile = false;
+}
+
+int World::_get_chunk_id( int tile_id ) const
+{
+	const int x = tile_id % _tiles_width;
+	const int y = tile_id / _tiles_width;
+	return ( y / WORLD_CHUNK_SIZE ) * _chunks_width + x / WORLD_CHUNK_SIZE;
+}
+
+const TileOccupancy* World::_find_tile( int tile_id ) const
+{
+	const WorldChunk& chunk = _chunks[_get_chunk_id( tile_id )];
+	if ( chunk.tiles.empty() ) return nullptr;
+
+	const int x = tile_id % _tiles_width;
+	const int y = tile_id / _tiles_width;
+	return &chunk.tiles[( y % WORLD_CHUNK_SIZE ) * WORLD_CHUNK_SIZE + x % WORLD_CHUNK_SIZE];
+}
+
+TileOccupancy& World::_get_or_create_tile( int tile_id )
+{
+	WorldChunk& chunk = _chunks[_get_chunk_id( tile_id )];
+	if ( chunk.tiles.empty() )
+	{
+		chunk.tiles.resize( WORLD_CHUNK_SIZE * WORLD_CHUNK_SIZE );
+	}
+
+	const int x = tile_id % _tiles_width;
+	const int y = tile_id / _tiles_width;
+	return chunk.tiles[( y % WORLD_CHUNK_SIZE ) * WORLD_CHUNK_SIZE + x % WORLD_CHUNK_SIZE];
+}
+
+void World::_rebuild_tile_occupancy()
+{
+	//  Tiles are integer positions within the world bounds
+	const Box bounds = get_bounds();
+	_tiles_origin_x = static_cast<int>( math::ceil( bounds.min.x ) );
+	_tiles_origin_y = static_cast<int>( math::ceil( bounds.min.y ) );
+	_tiles_width = math::max( 0, static_cast<int>( math::floor( bounds.max.x ) ) - _tiles_origin_x + 1 );
+	_tiles_height = math::max( 0, static_cast<int>( math::floor( bounds.max.y ) ) - _tiles_origin_y + 1 );
+
+	//  Chunks on the far edges may be partially outside the bounds, at least one chunk
+	//  is kept to store the grid cells of a world without tiles
+	_chunks_width = math::max( 1, ( _tiles_width + WORLD_CHUNK_SIZE - 1 ) / WORLD_CHUNK_SIZE );
+	_chunks_height = math::max( 1, ( _tiles_height + WORLD_CHUNK_SIZE - 1 ) / WORLD_CHUNK_SIZE );
+	_chunks.clear();
+	_chunks.resize( static_cast<size_t>( _chunks_width * _chunks_height ) );
+	_out_of_bounds_pawns.clear();
+
+	for ( const SafePtr<Pawn>& pawn : _pawns )
+	{
+		pawn->_tile_id = -1;
+		pawn->_tile_index = -1;
+		pawn->_chunk_id = -1;
+		pawn->_chunk_index = -1;
+		pawn->_is_chunk_mobile = false;
+		_add_pawn_to_tile( pawn );
+	}
+}
+
+void World::_add_pawn_to_tile( const SafePtr<Pawn>& pawn )
+{
+	const int tile_id = _get_tile_id( pawn->get_tile_pos() );
+	pawn->_tile_id = tile_id;
+
+	if ( tile_id == OUT_OF_BOUNDS_TILE_ID )
+	{
+		pawn->_tile_index = static_cast<int>( _out_of_bounds_pawns.size() );
+		_out_of_bounds_pawns.push_back( pawn );
+		return;
+	}
+
+	TileOccupancy& tile = _get_or_create_tile( tile_id );
+	pawn->_tile_index = static_cast<int>( tile.pawns.size() );
+	tile.pawns.push_back( pawn );
+	tile.adjectives_union = tile.adjectives_union | pawn->data->adjectives;
+	tile.adjectives_intersection = tile.adjectives_intersection & pawn->data->adjectives;
+
+	_add_pawn_to_chunk( pawn, _get_chunk_id( tile_id ) );
+}
+
+SafePtr<Pawn> World::_remove_pawn_from_tile( Pawn* pawn )
+{
+	if ( pawn->_tile_id == -1 ) return nullptr;
+
+	SafePtr<Pawn> removed_pawn = nullptr;
+	if ( pawn->_tile_id == OUT_OF_BOUNDS_TILE_ID )
+	{
+		removed_pawn = _swap_and_pop_pawn( _out_of_bounds_pawns, pawn->_tile_index, &Pawn::_tile_index );
+	}
+	else
+	{
+		TileOccupancy& tile = _get_or_create_tile( pawn->_tile_id );
+		removed_pawn = _swap_and_pop_pawn( tile.pawns, pawn->_tile_index, &Pawn::_tile_index );
+		_refresh_tile_adjectives( tile );
+
+		_remove_pawn_from_chunk( pawn );
+	}
+
+	pawn->_tile_id = -1;
+	pawn->_tile_index = -1;
+	return removed_pawn;
+}
+
+void World::_refresh_tile_adjectives( TileOccupancy& tile ) const
+{
+	tile.adjectives_union = Adjectives::None;
+	tile.adjectives_intersection = Adjectives::All;
+
+	for ( const SafePtr<Pawn>& pawn : tile.pawns )
+	{
+		tile.adjectives_union = tile.adjectives_union | pawn->data->adjectives;
+		tile.adjectives_intersection = tile.adjectives_intersection & pawn->data->adjectives;
+	}
+}
+
+int World::_get_tile_id( const Vec3& tile_pos ) const
+{
+	const int x = static_cast<int>( math::floor( tile_pos.x + 0.5f ) ) - _tiles_origin_x;
+	const int y = static_cast<int>( math::floor( tile_pos.y + 0.5f ) ) - _tiles_origin_y;
+	if ( x < 0 || x >= _tiles_width || y < 0 || y >= _tiles_height ) return OUT_OF_BOUNDS_TILE_ID;
+
+	return y * _tiles_width + x;
+}
+
+const PawnQueryCacheEntry* World::_find_query_cache( const Pawn* requester, PawnQueryType type, float radius ) const
+{
+	const PawnQueryCacheEntry& cache = requester->_query_cache[static_cast<uint8>( type )];
+
+	bool is_valid = cache.tick != -1
+				 && _tick - cache.tick <= query_cache_staleness_ticks
+				 && cache.radius == radius
+				 && cache.requester_tile_pos == requester->get_tile_pos();
+
+	//  Invalidate when the target died or moved
+	if ( is_valid && cache.has_target )
+	{
+		is_valid = cache.target.is_valid()
+				&& !cache.target->is_killed()
+				&& cache.target->get_tile_pos() == cache.target_tile_pos;
+	}
+
+	if ( !is_valid )
+	{
+		_query_cache_misses++;
+		return nullptr;
+	}
+
+	_query_cache_hits++;
+	return &cache;
+}
+
+void World::_store_query_cache( const Pawn* requester, PawnQueryType type, float radius, const SafePtr<Pawn>& target ) const
+{
+	PawnQueryCacheEntry& cache = requester->_query_cache[static_cast<uint8>( type )];
+	cache.target = target;
+	cache.has_target = target.is_valid();
+	cache.requester_tile_pos = requester->get_tile_pos();
+	cache.target_tile_pos = cache.has_target ? target->get_tile_pos() : Vec3::zero;
+	cache.radius = radius;
+	cache.tick = _tick;
+}
+
+bool World::_is_threat_field_prey( const Pawn* pawn )
+{
+	return pawn->data->has_adjective( Adjectives::Meat )
+		&& !pawn->data->has_adjective( Adjectives::Carnivore );
+}
+
+int World::_get_food_field_index( Adjectives food_adjective )
+{
+	switch ( food_adjective )
+	{
+		case Adjectives::Vegetal:
+			return 0;
+		case Adjectives::Meat:
+			return 1;
+		default:
+			return -1;
+	}
+}
+
+void World::_rebuild_food_fields()
+{
+	for ( PawnDistanceField& food_field : _food_fields )
+	{
+		food_field.resize( _tiles_width, _tiles_height, food_field_radius, WORLD_CHUNK_SIZE );
+	}
+
+	for ( const SafePtr<Pawn>& pawn : _pawns )
+	{
+		std::fill( std::begin( pawn->_food_field_source_ids ), std::end( pawn->_food_field_source_ids ), -1 );
+		_add_pawn_to_food_fields( pawn );
+	}
+
+	for ( PawnDistanceField& food_field : _food_fields )
+	{
+		food_field.propagate();
+	}
+}
+
+void World::_add_pawn_to_food_fields( const SafePtr<Pawn>& pawn )
+{
+	//  Out-of-bounds pawns are not part of the fields
+	if ( pawn->_tile_id < 0 ) return;
+
+	//  Pawns eating a food are kept out of its field, see World::find_food_for
+	constexpr Adjectives FOOD_ADJECTIVES[FOOD_FIELDS_COUNT] { Adjectives::Vegetal, Adjectives::Meat };
+	constexpr Adjectives EATER_ADJECTIVES[FOOD_FIELDS_COUNT] { Adjectives::Herbivore, Adjectives::Carnivore };
+	for ( int i = 0; i < FOOD_FIELDS_COUNT; i++ )
+	{
+		if ( !pawn->data->has_adjective( FOOD_ADJECTIVES[i] ) ) continue;
+		if ( pawn->data->has_adjective( EATER_ADJECTIVES[i] ) ) continue;
+
+		pawn->_food_field_source_ids[i] = _food_fields[i].add_source( pawn, pawn->_tile_id );
+	}
+}
+
+void World::_remove_pawn_from_food_fields( Pawn* pawn )
+{
+	for ( int i = 0; i < FOOD_FIELDS_COUNT; i++ )
+	{
+		int& source_id = pawn->_food_field_source_ids[i];
+		if ( source_id == -1 ) continue;
+
+		_food_fields[i].remove_source( source_id );
+		source_id = -1;
+	}
+}
+
+void World::_add_pawn_to_lists( const SafePtr<Pawn>& pawn )
+{
+	ASSERT_MSG( pawn->_data_list_id == -1, "A pawn is already registered in the World membership lists!" );
+
+	std::vector<SafePtr<Pawn>>& data_pawns = _pawns_by_data[pawn->data.get()];
+	pawn->_data_list_id = static_cast<int>( data_pawns.size() );
+	data_pawns.push_back( pawn );
+
+	_add_pawn_to_adjective_lists( pawn );
+}
+
+void World::_remove_pawn_from_lists( Pawn* pawn )
+{
+	if ( pawn->_data_list_id == -1 ) return;
+
+	_remove_pawn_from_adjective_lists( pawn );
+
+	_swap_and_pop_pawn( _pawns_by_data[pawn->data.get()], pawn->_data_list_id, &Pawn::_data_list_id );
+
+	pawn->_data_list_id = -1;
+}
+
+void World::_add_pawn_to_adjective_lists( const SafePtr<Pawn>& pawn )
+{
+	const Adjectives adjectives = pawn->data->adjectives;
+	for ( int bit = 0; bit < ADJECTIVES_COUNT; bit++ )
+	{
+		const Adjectives adjective = static_cast<Adjectives>( 1u << bit );
+		if ( ( adjectives & adjective ) != adjective ) continue;
+
+		std::vector<SafePtr<Pawn>>& pawns = _pawns_by_adjective[bit];
+		pawn->_adjective_list_ids[bit] = static_cast<int>( pawns.size() );
+		pawns.push_back( pawn );
+	}
+
+	pawn->_listed_adjectives = adjectives;
+}
+
+void World::_remove_pawn_from_adjective_lists( Pawn* pawn )
+{
+	for ( int bit = 0; bit < ADJECTIVES_COUNT; bit++ )
+	{
+		const int index = pawn->_adjective_list_ids[bit];
+		if ( index == -1 ) continue;
+
+		//  Swap with the last pawn of the list and fix its index
+		std::vector<SafePtr<Pawn>>& pawns = _pawns_by_adjective[bit];
+		if ( index != static_cast<int>( pawns.size() ) - 1 )
+		{
+			pawns[index] = std::move( pawns.back() );
+			pawns[index]->_adjective_list_ids[bit] = index;
+		}
+		pawns.pop_back();
+
+		pawn->_adjective_list_ids[bit] = -1;
+	}
+
+	pawn->_listed_adjectives = Adjectives::None;
 }
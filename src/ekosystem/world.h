@@ -1,12 +1,21 @@
 #pragma once
 
+#include <atomic>
+#include <chrono>
 #include <map>
+#include <random>
+#include <unordered_map>
+#include <unordered_set>
 
 #include <suprengine/core/entity.h>
 
 #include <suprengine/math/box.h>
 
 #include <ekosystem/data/pawn-data.h>
+#include <ekosystem/entities/pawn-handle.h>
+#include <ekosystem/pawn-distance-field.h>
+#include <ekosystem/pawn-timer-wheel.h>
+#include <ekosystem/job-system.h>
 
 namespace suprengine
 {
@@ -22,12 +31,197 @@ namespace eks
 	using GroupID = uint8_t;
 	enum { MAX_PAWN_GROUP_ID = 10 };
 
+	//  Size in tiles of a spatial grid cell used to speed up pawns queries
+	enum { PAWN_GRID_CELL_SIZE = 4 };
+
+	//  Size in tiles of the square chunks splitting the world
+	enum { WORLD_CHUNK_SIZE = 32 };
+
+	//  Number of spatial grid cells along each side of a chunk
+	enum { CHUNK_GRID_SIZE = WORLD_CHUNK_SIZE / PAWN_GRID_CELL_SIZE };
+	static_assert( WORLD_CHUNK_SIZE % PAWN_GRID_CELL_SIZE == 0, "Chunks must be made of whole grid cells" );
+
+	//  Number of food adjectives having a distance field of their nearest pawns (Vegetal and Meat)
+	enum { FOOD_FIELDS_COUNT = 2 };
+
+	//  Number of pawns, or queries, handed at once to a job of the world's job system
+	enum { PAWN_TICK_BATCH_SIZE = 256 };
+	enum { QUERY_BATCH_SIZE = 64 };
+
+	/*
+	 * Types of pawn queries the world resolves in batches and caches.
+	 */
+	enum class PawnQueryType : uint8
+	{
+		/*
+		 * Nearest pawn the requester can eat, see World::find_food_for.
+		 */
+		Food,
+		/*
+		 * Nearest pawn the requester can mate with, see World::find_mate_for.
+		 */
+		Mate,
+		/*
+		 * Nearest pawn the requester should flee from, see World::find_threat_for.
+		 */
+		Threat,
+	};
+	enum { PAWN_QUERY_TYPES_COUNT = 3 };
+
+	/*
+	 * Query requested by a pawn, resolved by the world in the batch of its next tick.
+	 */
+	struct PawnQuery
+	{
+		PawnHandle requester {};
+		PawnQueryType type = PawnQueryType::Food;
+		//  Search radius in tiles, used by threat queries
+		float radius = 0.0f;
+		//  Grid cell of the requester, used to sort the queries
+		int cell_id = -1;
+	};
+
+	/*
+	 * Children birth requested by a pawn, placed and spawned by the world at its next update.
+	 */
+	struct PawnBirth
+	{
+		SafePtr<PawnData> data = nullptr;
+		//  Tile position of the parent, the children are placed around it
+		Vec3 parent_tile_pos = Vec3::zero;
+		GroupID group_id = 0;
+		//  Occupants having all these adjectives don't prevent a child from being placed on their tile
+		Adjectives adjectives_filter = Adjectives::None;
+		int children_count = 0;
+	};
+
+	/*
+	 * Types of deferred writes to other pawns, applied by the world at the end of each tick.
+	 */
+	enum class PawnCommandType : uint8
+	{
+		/*
+		 * Kills the target. If set, the instigator eats it and gains its food amount.
+		 * Ignored when the target is already dead, so only the first eater gets the food.
+		 */
+		Kill,
+		/*
+		 * Adds the amount to the hunger of the target, up to its maximum hunger.
+		 */
+		HungerDelta,
+		/*
+		 * Sets the partner of the target to the instigator, or clears it with a null instigator.
+		 */
+		PartnerLink,
+	};
+
+	/*
+	 * Write to another pawn requested during a tick, see PawnCommandType.
+	 */
+	struct PawnCommand
+	{
+		PawnCommandType type = PawnCommandType::Kill;
+		PawnHandle target {};
+		PawnHandle instigator {};
+		float amount = 0.0f;
+	};
+
+	/*
+	 * Level of detail of a pawn's AI, from its distance to the focus of the world.
+	 * Each tier ticks its pawns every few fixed steps, see World::ai_lod_tick_intervals.
+	 */
+	enum class PawnAILod : uint8
+	{
+		/*
+		 * Close to the focus, ticked at every fixed step.
+		 */
+		Near,
+		Medium,
+		/*
+		 * Far from the focus, or without any focus (e.g. headless).
+		 */
+		Far,
+	};
+	enum { PAWN_AI_LODS_COUNT = 3 };
+
+	/*
+	 * Cached result of a pawn query, re-used until stale or until the requester or its target moves.
+	 */
+	struct PawnQueryCacheEntry
+	{
+		SafePtr<Pawn> target = nullptr;
+		bool has_target = false;
+
+		//  Tile positions of the requester and of the target when cached
+		Vec3 requester_tile_pos = Vec3::zero;
+		Vec3 target_tile_pos = Vec3::zero;
+		float radius = 0.0f;
+
+		//  World tick at which the result was cached, -1 if empty
+		int tick = -1;
+	};
+
+	/*
+	 * Hot state of the registered pawns, read and written by their ticks and by the queries.
+	 * Stored by the world as a structure of arrays in the order of its pawns list, so iterating
+	 * the pawns walks contiguous memory, see Pawn::_world_index.
+	 */
+	struct PawnHotStates
+	{
+		std::vector<Vec3> tile_positions {};
+		std::vector<float> hungers {};
+		//  Index of the current state inside the pawn's state machine, -1 without any
+		std::vector<int> state_ids {};
+	};
+
+	/*
+	 * Occupancy of a single tile of the world.
+	 */
+	struct TileOccupancy
+	{
+		std::vector<SafePtr<Pawn>> pawns {};
+
+		//  Adjectives of all occupants OR-ed together
+		Adjectives adjectives_union = Adjectives::None;
+		//  Adjectives shared by all occupants, All if empty
+		Adjectives adjectives_intersection = Adjectives::All;
+	};
+
+	/*
+	 * Square area of WORLD_CHUNK_SIZE² tiles, holding its own pawns, tiles occupancy and grid cells.
+	 */
+	struct WorldChunk
+	{
+		std::vector<SafePtr<Pawn>> pawns {};
+		//  Number of pawns able to move, the chunk is dormant without any
+		int mobile_pawns_count = 0;
+		//  Time elapsed since the last coarse update of its pawns
+		float dormant_time = 0.0f;
+
+		//  Occupancy of the chunk tiles, only allocated while pawns are in the chunk
+		std::vector<TileOccupancy> tiles {};
+
+		//  Spatial grid cells of the chunk, only allocated while pawns are in them. Out-of-bounds
+		//  pawns are bucketed in the nearest edge cell, so the cells may hold pawns of no chunk.
+		std::vector<std::vector<SafePtr<Pawn>>> grid_cells {};
+		int grid_pawns_count = 0;
+	};
+
 	class World
 	{
 	public:
-		World( const Vec2& size );
+		/*
+		 * Creates a world of the given size in tiles. The optional job system spreads
+		 * the pawn ticks and the queries over its threads.
+		 */
+		World( const Vec2& size, JobSystem* job_system = nullptr );
 		~World();
 
+		/*
+		 * Advances the simulation by the given elapsed time, in as many fixed steps as
+		 * the accumulated time covers. The remaining time is kept for the next update.
+		 * Each step ticks all pawns in a single pass.
+		 */
 		void update( float dt );
 
 		SharedPtr<Pawn> create_pawn(
@@ -43,11 +237,126 @@ namespace eks
 
 		int get_pawns_count_in_group( GroupID group_id ) const;
 
+		/*
+		 * Queues the birth of children to be spawned at the end of the current tick.
+		 */
+		void enqueue_birth( const PawnBirth& birth );
+		/*
+		 * Places all queued children against the same tiles occupancy, so siblings never
+		 * share a tile, then spawns them at once. Called at the end of each tick.
+		 */
+		void spawn_pending_births();
+
+		/*
+		 * Queues a write to another pawn, applied at the end of the current tick so the
+		 * pawns never change while being ticked.
+		 */
+		void enqueue_command( const PawnCommand& command );
+		/*
+		 * Applies the queued commands in their order, resolving the conflicts (e.g. a pawn
+		 * eaten twice), then spawns the queued births. Called at the end of each tick.
+		 */
+		void apply_commands();
+		int get_pending_commands_count() const;
+		/*
+		 * Returns the number of children queued to be born in this group.
+		 */
+		int get_pending_births_count_in_group( GroupID group_id ) const;
+
+		/*
+		 * Returns whenever the pawn is inside a dormant chunk, i.e. a chunk without any
+		 * mobile pawn. Dormant pawns are only advanced by the world's coarse updates.
+		 */
+		bool is_pawn_dormant( const Pawn* pawn ) const;
+		int get_chunks_count() const;
+		int get_dormant_chunks_count() const;
+
+		/*
+		 * Suspends the state machine of the pawn for the given time in seconds, its needs
+		 * are still ticked. It is woken up by the world's timer wheel once the time is over,
+		 * or earlier by a carnivore coming within 'threat_wake_radius' if it is a prey.
+		 * Does nothing if the timer wheel is disabled.
+		 */
+		void suspend_pawn( Pawn* pawn, float duration );
+		/*
+		 * Resumes the state machine of a suspended pawn. If interrupted, its current task
+		 * fails so its state machine selects its state again at the next tick.
+		 */
+		void wake_pawn( Pawn* pawn, bool is_interrupted = false );
+		int get_suspended_pawns_count() const;
+
+		/*
+		 * Sets the tile position the AI level of details are computed from, usually the
+		 * camera's focus. Without any focus, all pawns are in the far tier.
+		 */
+		void set_ai_lod_focus( const Vec3& tile_pos );
+		void clear_ai_lod_focus();
+		bool has_ai_lod_focus() const;
+		int get_pawns_count_in_ai_lod( PawnAILod ai_lod ) const;
+
+		/*
+		 * Returns the time in microseconds spent running the fixed steps of the last update.
+		 * Only measured when the frame budget is enabled, see 'ai_frame_budget_us'.
+		 */
+		float get_ai_budget_spent_us() const;
+		/*
+		 * Returns the number of pawns whose actions tick was postponed by the frame budget
+		 * at the end of the last update.
+		 */
+		int get_ai_backlog_count() const;
+		/*
+		 * Returns the largest simulated time in seconds not yet handed to a postponed pawn,
+		 * including the time left over by the fixed steps the frame budget could not run.
+		 */
+		float get_ai_lag() const;
+
+		/*
+		 * Returns the pawn referenced by the handle, or nullptr if it has been removed.
+		 */
+		Pawn* get_pawn( PawnHandle handle ) const;
+		bool is_pawn_valid( PawnHandle handle ) const;
+
 		void resize( const Vec2& size );
 		void clear();
 
-		bool find_empty_tile_pos_around( const Vec3& pos, Vec3* out, Adjectives adjectives_filter = Adjectives::None ) const;
+		/*
+		 * Returns whenever a pawn occupies the given tile.
+		 * If an adjectives filter is given, pawns having all these adjectives are ignored.
+		 */
+		bool is_tile_occupied( const Vec3& tile_pos, Adjectives adjectives_filter = Adjectives::None ) const;
+		/*
+		 * Returns the adjectives of all pawns occupying the given tile OR-ed together.
+		 */
+		Adjectives get_tile_adjectives( const Vec3& tile_pos ) const;
+
+		/*
+		 * Finds an empty tile around the position. If a reservation set is given, the tiles
+		 * it contains are skipped and the found tile is added to it.
+		 */
+		bool find_empty_tile_pos_around(
+			const Vec3& pos,
+			Vec3* out,
+			Adjectives adjectives_filter = Adjectives::None,
+			std::unordered_set<int>* reserved_tile_ids = nullptr
+		) const;
+		/*
+		 * Returns the position of a random tile inside the world's chunks.
+		 */
 		Vec3 find_random_tile_pos() const;
+
+		/*
+		 * Re-seeds the random generator of the simulation, so runs starting from the same seed
+		 * and pawns end up with the same results whatever the threads count.
+		 */
+		void set_random_seed( uint32_t seed );
+		/*
+		 * Generates random values from the simulation's generator. Only called by the serial
+		 * parts of a tick, so the values are drawn in the same order whatever the threads count.
+		 */
+		int generate_random( int min, int max ) const;
+		float generate_random( float min, float max ) const;
+		int generate_random_sign() const;
+
 		SafePtr<Pawn> find_pawn_with(
 			Adjectives adjectives,
 			SafePtr<Pawn> pawn_to_ignore
@@ -60,19 +369,193 @@ namespace eks
 			const Vec3& origin,
 			std::function<bool( SafePtr<Pawn> )> callback
 		) const;
+		/*
+		 * Finds the nearest pawn having all the given adjectives and accepted by the callback.
+		 * Only the pawns listed under these adjectives are considered.
+		 */
+		SafePtr<Pawn> find_nearest_pawn_with(
+			Adjectives adjectives,
+			const Vec3& origin,
+			std::function<bool( SafePtr<Pawn> )> callback
+		) const;
+		/*
+		 * Finds the nearest pawn using the given data and accepted by the callback.
+		 * Only the pawns listed under this data are considered.
+		 */
+		SafePtr<Pawn> find_nearest_pawn_of(
+			const PawnData* data,
+			const Vec3& origin,
+			std::function<bool( SafePtr<Pawn> )> callback
+		) const;
 		SafePtr<Pawn> find_pawn(
 			std::function<bool( SafePtr<Pawn> )> callback
 		) const;
 
+		/*
+		 * Templated overloads of the queries above, accepting any callable taking a
+		 * 'const SafePtr<Pawn>&' so the filters can be inlined in the hot paths.
+		 * Defined in 'world-queries.hpp', included by 'entities/pawn.h'.
+		 */
+		template <typename FilterType>
+		SafePtr<Pawn> find_nearest_pawn( const Vec3& origin, FilterType&& filter ) const;
+		template <typename FilterType>
+		SafePtr<Pawn> find_nearest_pawn_with(
+			Adjectives adjectives,
+			const Vec3& origin,
+			FilterType&& filter
+		) const;
+		template <typename FilterType>
+		SafePtr<Pawn> find_nearest_pawn_of(
+			const PawnData* data,
+			const Vec3& origin,
+			FilterType&& filter
+		) const;
+		template <typename FilterType>
+		SafePtr<Pawn> find_pawn( FilterType&& filter ) const;
+
+		/*
+		 * Finds the nearest pawn within the radius (in tiles) accepted by the filter.
+		 * If adjectives are given, only the pawns having all of them are considered.
+		 * Only the grid cells covered by the radius are visited.
+		 */
+		template <typename FilterType>
+		SafePtr<Pawn> find_nearest_pawn_in_radius(
+			const Vec3& origin,
+			float radius,
+			FilterType&& filter,
+			Adjectives adjectives = Adjectives::None
+		) const;
+		/*
+		 * Calls the function for each pawn within the radius (in tiles) accepted by the filter.
+		 * Only the grid cells covered by the radius are visited.
+		 */
+		template <typename FilterType, typename FunctionType>
+		void for_each_pawn_in_radius(
+			const Vec3& origin,
+			float radius,
+			FilterType&& filter,
+			FunctionType&& function
+		) const;
+
+		/*
+		 * Finds the nearest pawn the given pawn can eat according to its diet.
+		 * The food fields are read first, falling back to a search when they can't answer.
+		 * The result is cached, see 'query_cache_staleness_ticks'.
+		 */
+		SafePtr<Pawn> find_food_for( const Pawn* pawn ) const;
+		/*
+		 * Finds the nearest pawn of the same data as the given pawn and wanting to mate.
+		 */
+		SafePtr<Pawn> find_mate_for( const Pawn* pawn ) const;
+		/*
+		 * Finds the nearest pawn within the radius (in tiles) the given pawn should flee from.
+		 * The result is cached, see 'query_cache_staleness_ticks'.
+		 */
+		SafePtr<Pawn> find_threat_for( const Pawn* pawn, float radius ) const;
+
+		int get_query_cache_hits() const;
+		int get_query_cache_misses() const;
+		void reset_query_cache_stats();
+
+		/*
+		 * Requests the query to be resolved in the batch of the next fixed step the requester is
+		 * ticked at. Its result is then read from the query cache by the matching find function.
+		 * Only writes to the requester, so it can be called during the decision phase.
+		 */
+		void request_query( const Pawn* requester, PawnQueryType type, float radius = 0.0f ) const;
+		/*
+		 * Returns the total number of queries resolved by the batches.
+		 */
+		int64_t get_batched_queries_count() const;
+
+		/*
+		 * Rebuilds the per-tile field of the nearest carnivores, propagated from all
+		 * of them at once up to the threat field radius. Called at each world update.
+		 */
+		void rebuild_threat_field();
+		/*
+		 * Returns the nearest carnivore within the radius (in tiles) of the given tile,
+		 * as of the last threat field rebuild.
+		 */
+		SafePtr<Pawn> get_threat_at( const Vec3& tile_pos, float radius ) const;
+		/*
+		 * Returns the 2D direction going down the threat field, away from all nearby carnivores.
+		 * Returns a zero vector if the pawn doesn't use the threat field or if the field is flat.
+		 */
+		Vec3 get_threat_flee_direction( const Pawn* pawn ) const;
+		/*
+		 * Returns the 2D direction going down the field of the given food adjective (Vegetal
+		 * or Meat), toward the nearest pawns having it. Returns a zero vector if the field is
+		 * flat there or if the tile is out of the world bounds.
+		 */
+		Vec3 get_food_direction( Adjectives food_adjective, const Vec3& tile_pos ) const;
+
+		/*
+		 * Resolves the requested queries in one pass, sorted by grid cell so consecutive
+		 * searches visit the same cells. Food and threat queries are searched in parallel
+		 * and cached for their requester, mate queries pair their requester with its nearest
+		 * unpaired candidate of the same data, both partners at once so a pawn can't be
+		 * claimed twice. Called at each fixed step, before ticking the pawns.
+		 */
+		void resolve_queries();
+
+		/*
+		 * Re-registers the pawns using this data into the adjectives membership lists.
+		 * Must be called after editing the adjectives of a data at runtime.
+		 */
+		void refresh_pawn_data_adjectives( const PawnData* data );
+
+		/*
+		 * Moves the pawn to the spatial grid cell matching its current tile position.
+		 * Called by the pawn whenever its tile position is updated.
+		 */
+		void on_pawn_tile_pos_changed( Pawn* pawn );
+		/*
+		 * Moves the pawn from its previous group population counter to its current one.
+		 * Called by the pawn whenever its group is changed.
+		 */
+		void on_pawn_group_id_changed( Pawn* pawn, GroupID previous_group_id );
+		/*
+		 * Registers or unregisters the pawn from the mate candidates of its data.
+		 * Called by the pawn whenever it starts or stops looking for a mate.
+		 */
+		void on_pawn_wants_to_mate_changed( Pawn* pawn );
+		/*
+		 * Unregisters the pawn from all the world structures in constant time, so it can't be
+		 * targeted anymore. Called by the pawn when it is killed.
+		 */
+		void on_pawn_killed( Pawn* pawn );
+
 		Vec3 world_to_grid( const Vec3& world_pos ) const;
 		Vec3 grid_to_world( const Vec3& grid_pos ) const;
 
+		/*
+		 * Returns all the pawns of the world.
+		 * 
+		 * The order is unspecified: new pawns are appended at the end and a removed
+		 * pawn is replaced by the last one. Pawns are removed as soon as they are killed,
+		 * except the ones killed while ticked, which are removed at the end of the tick.
+		 * When the Morton ordering is enabled, the list is also re-sorted by the fixed steps.
+		 */
 		const std::vector<SafePtr<Pawn>>& get_pawns() const;
+		/*
+		 * Returns the pawns having the given single-bit adjective.
+		 */
+		const std::vector<SafePtr<Pawn>>& get_pawns_with( Adjectives adjective ) const;
+		/*
+		 * Returns the pawns using the given data.
+		 */
+		const std::vector<SafePtr<Pawn>>& get_pawns_of( const PawnData* data ) const;
 		std::map<std::string, SharedPtr<PawnData>>& get_pawn_datas();
 		const std::map<std::string, SharedPtr<PawnData>>& get_pawn_datas() const;
 		
 		Vec2 get_size() const;
 		Box get_bounds() const;
+		/*
+		 * Returns the box from the first to the last tile position covered by the chunks.
+		 * Unlike the world bounds, its corners are always on tiles, even for odd-sized worlds.
+		 */
+		Box get_tile_bounds() const;
 
 		Vec3 get_sun_direction() const;
 		float get_photosynthesis_multiplier() const;
@@ -80,18 +563,270 @@ namespace eks
 		bool is_within_world_time( float min_hours, float max_hours ) const;
 		float get_world_time() const;
 
+		/*
+		 * Returns the number of fixed steps since the world creation.
+		 */
+		int get_tick() const;
+		/*
+		 * Returns the number of fixed steps run by the last update.
+		 */
+		int get_fixed_steps_count() const;
+		/*
+		 * Returns the number of pawn ticks run since the world creation, counting the coarse
+		 * ticks of dormant chunks but not the pawns skipped by the AI level of detail or budget.
+		 */
+		int64_t get_pawn_ticks_count() const;
+		/*
+		 * Returns the progress, between 0 and 1, of the accumulated time toward the next
+		 * fixed step. Used to interpolate the rendering between the last two steps.
+		 */
+		float get_fixed_step_alpha() const;
+
+		/*
+		 * Returns the job system running the pawn ticks and the queries, nullptr if they run inline.
+		 * Results don't depend on its number of threads.
+		 */
+		JobSystem* get_job_system() const;
+
 	public:
 		const float TILE_SIZE = 10.0f;
 
+		//  Delta time in seconds of each simulation step, independent from the frame rate
+		float fixed_timestep = 1.0f / 60.0f;
+		//  Maximum number of fixed steps run by a single update, the time they can't cover is dropped
+		int max_fixed_steps_per_update = 128;
+		//  Maximum number of pawn ticks, summed over all fixed steps, run by a single update.
+		//  Lowers the steps of crowded worlds to keep the frame time bounded, 0 to disable.
+		int max_pawn_ticks_per_update = 0;
+
 		float world_time_scale = 0.5f;
 		float pawn_hunger_sleep_modifier = 0.0f;
 
+		//  Maximum distance in tiles the threat field is propagated to
+		float threat_field_radius = 8.0f;
+		//  Maximum distance in tiles the food fields are propagated to, applied on resize
+		float food_field_radius = 16.0f;
+
+		//  Number of ticks a cached food or threat query stays valid, 0 to only re-use it within its tick
+		int query_cache_staleness_ticks = 0;
+		//  Whenever the food and threat queries requested by the pawns are resolved in a batch before
+		//  ticking them, they are only run when needed otherwise. Mate queries always go through the batch.
+		bool is_query_batch_enabled = true;
+
+		//  Whenever the pawns and their hot state are periodically re-sorted along a Z-order curve
+		//  of their tile, so the ticks visit neighbour pawns one after the other. Handles are kept.
+		bool is_morton_ordering_enabled = false;
+		//  Number of ticks between two re-sorts of the pawns
+		int morton_ordering_interval_ticks = 60;
+
+		//  Whenever chunks without mobile pawns are only advanced by coarse updates
+		bool is_chunk_dormancy_enabled = true;
+		//  Time in seconds between two coarse updates of a dormant chunk
+		float dormant_chunk_update_period = 0.5f;
+
+		//  Whenever waiting pawns suspend their state machine until woken by the timer wheel
+		bool is_timer_wheel_enabled = true;
+		//  Distance in tiles within which a carnivore wakes up the suspended prey
+		float threat_wake_radius = 4.0f;
+
+		//  Whenever the pawns with a state machine are ticked at the rate of their AI level of detail,
+		//  all pawns are ticked at every fixed step otherwise
+		bool is_ai_lod_enabled = true;
+		//  Maximum distances in tiles to the focus of the near and medium tiers
+		float ai_lod_distances[PAWN_AI_LODS_COUNT - 1] { 12.0f, 24.0f };
+		//  Number of fixed steps between two ticks of a pawn, per tier. The pawns in between
+		//  accumulate the elapsed time, handed over at their next tick.
+		int ai_lod_tick_intervals[PAWN_AI_LODS_COUNT] { 1, 4, 16 };
+
+		//  Maximum time in microseconds spent running the fixed steps of a single update, 0 to disable.
+		//  No more steps are run once another one would not fit, and inside a step the pawns are ticked
+		//  round-robin, the ones left over keep their accumulated time for the next step.
+		//  NOTE: Opt-in since the simulation then depends on the speed of the machine.
+		int ai_frame_budget_us = 0;
+		//  Maximum number of pawn ticks run by the fixed steps of a single update, 0 to disable.
+		//  Budgets the frame like 'ai_frame_budget_us' while keeping the simulation deterministic.
+		int ai_frame_budget_ticks = 0;
+		//  Maximum time in seconds the fixed steps can fall behind when stopped by the frame budget,
+		//  the time over it is dropped like the one the capped steps could not cover
+		float max_ai_backlog_time = 0.25f;
+
 	private:
+		friend class Pawn;
+
+		/*
+		 * Advances the world state and its pawns by a single fixed step.
+		 */
+		void _fixed_update( float dt, bool is_last_step );
+		/*
+		 * Ticks all the pawns not already advanced by their dormant chunk.
+		 */
+		void _tick_pawns( float dt, bool is_last_step );
+		/*
+		 * Wakes up the suspended pawns whose timer expired, then the prey near a carnivore.
+		 */
+		void _wake_suspended_pawns();
+		/*
+		 * Assigns the AI level of detail of all pawns from their distance to the focus.
+		 */
+		void _update_ai_lods();
+		/*
+		 * Returns whenever the pawn is ticked at the current fixed step, according to its
+		 * AI level of detail. Pawns of the same tier are spread over the steps by their slot.
+		 */
+		bool _is_ai_lod_tick( const Pawn* pawn ) const;
+		/*
+		 * Returns whenever the fixed steps are limited by a time or ticks frame budget.
+		 */
+		bool _is_ai_budgeted() const;
+	#ifndef EKOSYSTEM_HEADLESS
+		/*
+		 * Updates the sky, sun, moon and ambient lighting from the world time.
+		 */
+		void _update_day_night();
+	#endif
+
+		/*
+		 * Runs the function over [0; count) with the job system, or inline without it.
+		 */
+		void _parallel_for( int count, int batch_size, const JobSystem::RangeFunction& function ) const;
+
 		void _init_datas();
 
-		void _on_entity_removed( Entity* entity );
+		static bool _is_pawn_registered( const Pawn* pawn );
+		void _remove_pawn( Pawn* pawn );
+		/*
+		 * Moves the hot state of the pawn, kept by itself while not registered, at the end
+		 * of the world's hot states. Its index inside the pawns list must be assigned first.
+		 */
+		void _attach_pawn_hot_state( Pawn* pawn );
+		/*
+		 * Copies the hot state of the pawn back into it, before it is unregistered.
+		 */
+		void _detach_pawn_hot_state( Pawn* pawn ) const;
+		/*
+		 * Re-sorts the pawns list and their hot states by the Z-order code of their tile,
+		 * remapping the stored indexes. The handles are left untouched.
+		 */
+		void _reorder_pawns_by_morton();
+		uint32_t _get_morton_code( const Vec3& tile_pos ) const;
+		/*
+		 * Removes the pawn from everything the simulation looks pawns up with: its handle,
+		 * the queries, the distance fields, the mate candidates and the group counts.
+		 */
+		void _unregister_pawn_references( Pawn* pawn );
+		/*
+		 * Removes the pawn at the given index by moving the last pawn in its place
+		 * and updating its stored index. Returns the removed pawn.
+		 */
+		static SafePtr<Pawn> _swap_and_pop_pawn(
+			std::vector<SafePtr<Pawn>>& pawns,
+			int index,
+			int Pawn::* index_member
+		);
+
+		PawnHandle _allocate_pawn_slot( Pawn* pawn );
+		void _free_pawn_slot( Pawn* pawn );
+
+		void _rebuild_pawn_grid();
+		void _add_pawn_to_grid( const SafePtr<Pawn>& pawn );
+		SafePtr<Pawn> _remove_pawn_from_grid( Pawn* pawn );
+		void _get_grid_cell_coords( const Vec3& tile_pos, int* out_x, int* out_y ) const;
+		int _get_grid_cell_id( const Vec3& tile_pos ) const;
+		/*
+		 * Returns the chunk containing the grid cell and writes the index of the cell inside it.
+		 */
+		int _get_grid_cell_chunk_id( int cell_x, int cell_y, int* out_local_id ) const;
+		/*
+		 * Returns the pawns of the grid cell, or an empty list if its chunk has no allocated cells.
+		 */
+		const std::vector<SafePtr<Pawn>>& _get_grid_cell( int cell_x, int cell_y ) const;
+
+		/*
+		 * Calls the function for each existing grid cell located at the given
+		 * Chebyshev distance (in cells) from the origin cell. Cells of chunks
+		 * without pawns may be skipped.
+		 */
+		template <typename FunctionType>
+		void _for_each_grid_cell_in_ring( int origin_x, int origin_y, int ring, FunctionType&& function ) const;
+
+		/*
+		 * Finds the nearest pawn accepted by the filter within the maximum distance (in tiles)
+		 * by searching the grid ring by ring around the origin.
+		 */
+		template <typename FilterType>
+		SafePtr<Pawn> _find_nearest_pawn_in_grid( const Vec3& origin, FilterType&& filter, float max_dist ) const;
+		/*
+		 * Finds the nearest pawn accepted by the filter within the maximum distance (in tiles)
+		 * by scanning the given pawns.
+		 */
+		template <typename FilterType>
+		SafePtr<Pawn> _find_nearest_pawn_in_list(
+			const std::vector<SafePtr<Pawn>>& pawns,
+			const Vec3& origin,
+			FilterType&& filter,
+			float max_dist
+		) const;
+
+		/*
+		 * Advances the dormant chunks by a coarse update once their period has elapsed,
+		 * and catches up the chunks which just woke up. Also releases the tiles and grid
+		 * cells of the chunks left without pawns.
+		 */
+		void _update_chunks( float dt );
+		void _add_pawn_to_chunk( const SafePtr<Pawn>& pawn, int chunk_id );
+		void _remove_pawn_from_chunk( Pawn* pawn );
+		int _get_chunk_id( int tile_id ) const;
+		/*
+		 * Returns the occupancy of the in-bounds tile, or nullptr if its chunk is not allocated.
+		 */
+		const TileOccupancy* _find_tile( int tile_id ) const;
+		TileOccupancy& _get_or_create_tile( int tile_id );
+
+		void _rebuild_tile_occupancy();
+		void _add_pawn_to_tile( const SafePtr<Pawn>& pawn );
+		SafePtr<Pawn> _remove_pawn_from_tile( Pawn* pawn );
+		void _refresh_tile_adjectives( TileOccupancy& tile ) const;
+		int _get_tile_id( const Vec3& tile_pos ) const;
+
+		SafePtr<Pawn> _find_food_for( const Pawn* pawn ) const;
+		SafePtr<Pawn> _find_threat_for( const Pawn* pawn, float radius ) const;
+
+		/*
+		 * Returns the cached query of this type if still valid for the requester, nullptr otherwise.
+		 * Counts as a cache hit or miss.
+		 */
+		const PawnQueryCacheEntry* _find_query_cache( const Pawn* requester, PawnQueryType type, float radius ) const;
+		void _store_query_cache( const Pawn* requester, PawnQueryType type, float radius, const SafePtr<Pawn>& target ) const;
+		/*
+		 * Pairs the pawn with its nearest unpaired mate candidate, if any.
+		 */
+		void _match_mate( Pawn* pawn );
+
+		/*
+		 * Returns whenever the pawn's threats are exactly the carnivores of
+		 * the threat field, e.g. meat pawns which are not carnivores themselves.
+		 */
+		static bool _is_threat_field_prey( const Pawn* pawn );
+		static int _get_food_field_index( Adjectives food_adjective );
+
+		void _rebuild_food_fields();
+		void _add_pawn_to_food_fields( const SafePtr<Pawn>& pawn );
+		void _remove_pawn_from_food_fields( Pawn* pawn );
+
+		void _add_pawn_to_lists( const SafePtr<Pawn>& pawn );
+		void _remove_pawn_from_lists( Pawn* pawn );
+		void _add_pawn_to_adjective_lists( const SafePtr<Pawn>& pawn );
+		void _remove_pawn_from_adjective_lists( Pawn* pawn );
 
 	private:
+		int _tick = 0;
+		//  Elapsed time not yet covered by a fixed step
+		float _fixed_time_accumulator = 0.0f;
+		int _fixed_steps_count = 0;
+		int64_t _pawn_ticks_count = 0;
+
+		//  Jobs of the decision phase of the pawn ticks and of the queries, not owned
+		JobSystem* _job_system = nullptr;
 		float _world_time = 8.0f;
 		Vec3 _sun_direction = Vec3::zero;
 		float _photosynthesis_multiplier = 0.0f;
@@ -105,9 +840,99 @@ namespace eks
 		SafePtr<ModelRenderer> _skysphere_renderer = nullptr;
 		SafePtr<ModelRenderer> _ground_renderer = nullptr;
 		std::vector<SafePtr<Pawn>> _pawns {};
+		//  Hot state of the pawns, by index inside the pawns list
+		PawnHotStates _hot_states {};
+		//  Scratch storage of World::_reorder_pawns_by_morton, pairs of sort key and previous index
+		std::vector<std::pair<uint64_t, int>> _morton_keys {};
+
+		//  Slots referenced by the pawn handles, re-used once their pawn is removed
+		struct PawnSlot
+		{
+			Pawn* pawn = nullptr;
+			//  Never zero, so null handles are never resolved
+			uint32_t generation = 1;
+		};
+		std::vector<PawnSlot> _pawn_slots {};
+		std::vector<uint32_t> _free_pawn_slots {};
+
+		//  Pawns bucketed by cells of PAWN_GRID_CELL_SIZE² tiles, used by nearest queries. The cells
+		//  are aligned on the tiles and stored inside their chunk, see WorldChunk::grid_cells.
+		int _pawn_grid_width = 0;
+		int _pawn_grid_height = 0;
+
+		//  Chunks splitting the tiles inside the world bounds, out-of-bounds pawns are in no chunk
+		static constexpr int OUT_OF_BOUNDS_TILE_ID = -2;
+		std::vector<WorldChunk> _chunks {};
+		int _chunks_width = 0;
+		int _chunks_height = 0;
+		std::vector<SafePtr<Pawn>> _out_of_bounds_pawns {};
+		int _tiles_width = 0;
+		int _tiles_height = 0;
+		int _tiles_origin_x = 0;
+		int _tiles_origin_y = 0;
+
+		//  Intrusive membership lists, each pawn stores its index inside them
+		std::vector<SafePtr<Pawn>> _pawns_by_adjective[ADJECTIVES_COUNT] {};
+		std::unordered_map<const PawnData*, std::vector<SafePtr<Pawn>>> _pawns_by_data {};
+
+		//  Generator of the simulation's randomness, seeded randomly unless set
+		mutable std::mt19937 _random_engine { std::random_device {}() };
+
+		//  Atomics since the queries can be run by parallel jobs
+		mutable std::atomic<int> _query_cache_hits { 0 };
+		mutable std::atomic<int> _query_cache_misses { 0 };
+
+		//  Queries of the current batch, and total number of resolved ones
+		std::vector<PawnQuery> _queries {};
+		int64_t _batched_queries_count = 0;
+
+		//  Pawns wanting to mate, by data
+		std::unordered_map<const PawnData*, std::vector<SafePtr<Pawn>>> _mate_candidates {};
+
+		//  Nearest carnivore of each tile, cleared and rebuilt at each update
+		PawnDistanceField _threat_field {};
+		//  Nearest food of each tile, updated incrementally and propagated at each update
+		PawnDistanceField _food_fields[FOOD_FIELDS_COUNT] {};
 
 		std::map<std::string, SharedPtr<PawnData>> _pawn_datas {};
 
 		uint8 _group_limits[MAX_PAWN_GROUP_ID + 1] {};
+		int _group_counts[MAX_PAWN_GROUP_ID + 1] {};
+
+		std::vector<PawnCommand> _commands {};
+
+		//  Timers of the suspended pawns, stale ones are ignored once expired
+		PawnTimerWheel _timer_wheel {};
+		std::vector<PawnTimer> _expired_timers {};
+		int _suspended_pawns_count = 0;
+
+		//  Pawns killed while ticked, removed once the commit phase is over
+		bool _is_ticking_pawns = false;
+		std::vector<Pawn*> _killed_pawns {};
+
+		Vec3 _ai_lod_focus = Vec3::zero;
+		bool _has_ai_lod_focus = false;
+
+		//  Index of the pawn the next budgeted commit phase starts from
+		int _ai_budget_cursor = 0;
+		std::chrono::steady_clock::time_point _ai_budget_start_time {};
+		float _ai_budget_spent_us = 0.0f;
+		//  Duration in microseconds of the last fixed step, estimating the next one
+		float _step_cost_us = 0.0f;
+		//  Number of pawns ticked by the commit phases of the current update and of the last fixed step
+		int _ai_budget_ticks_count = 0;
+		int _step_ticks_count = 0;
+		bool _is_ai_budget_exceeded = false;
+		int _ai_backlog_count = 0;
+		float _ai_lag = 0.0f;
+		//  Accumulated time in seconds carried over after the frame budget stopped the fixed steps
+		float _ai_backlog_time = 0.0f;
+
+		std::vector<PawnBirth> _births {};
+		int _pending_births_counts[MAX_PAWN_GROUP_ID + 1] {};
+		//  Scratch storage of World::spawn_pending_births
+		std::vector<PawnBirth> _spawning_births {};
+		std::vector<std::pair<int, Vec3>> _birth_placements {};
+		std::unordered_set<int> _birth_tile_ids {};
 	};
 }
\ No newline at end of file